@@ -24,6 +24,11 @@ class IntegralConstant : public Expression<IntegralConstant<T, value>> {
     return value;
   }
 
+  template <class Profiler, class... X>
+  constexpr auto Profile(Profiler&, const X&... x) const noexcept {
+    return (*this)(x...);
+  }
+
   template <unsigned M>
   constexpr auto Derive() const noexcept {
     return IntegralConstant<int, 0>{};
@@ -63,6 +68,11 @@ class Constant : public Expression<Constant<T>> {
     return value;
   }
 
+  template <class Profiler, class... X>
+  constexpr auto Profile(Profiler&, const X&... x) const noexcept {
+    return (*this)(x...);
+  }
+
   template <unsigned M>
   constexpr auto Derive() const noexcept {
     return IntegralConstant<int, 0>();
@@ -82,4 +92,10 @@ template <class T>
 constexpr std::enable_if_t<std::is_arithmetic_v<T>, Constant<T>> ToExpression(const T& v) noexcept {
   return Constant<T>(v);
 }
+
+// Expression type that ToExpression produces for Arg. Factories name it explicitly: class template argument
+// deduction from a single expression argument would deduce the copy constructor, so _Negate(_Negate<E>) is a
+// _Negate<E> and not a _Negate<_Negate<E>>.
+template <class Arg>
+using expression_t = std::decay_t<decltype(ToExpression(std::declval<const Arg&>()))>;
 }  // namespace SymbolicMath
\ No newline at end of file
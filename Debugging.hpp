@@ -31,4 +31,16 @@ constexpr auto GetTypeName() -> std::string_view {
 template <typename T>
 constexpr auto GetTypeName(const T&) -> std::string_view {
   return GetTypeName<T>();
+}
+
+// "SymbolicMath::ImplDetails::_Sin<SymbolicMath::Variable<0> >" -> "_Sin"
+constexpr auto GetNodeName(std::string_view type_name) -> std::string_view {
+  type_name = type_name.substr(0, type_name.find('<'));
+  const auto scope = type_name.rfind("::");
+  return scope == std::string_view::npos ? type_name : type_name.substr(scope + 2);
+}
+
+template <typename T>
+constexpr auto GetNodeName() -> std::string_view {
+  return GetNodeName(GetTypeName<T>());
 }
\ No newline at end of file
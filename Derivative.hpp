@@ -6,11 +6,11 @@
 namespace SymbolicMath {
 template <class E, unsigned id, class... Rest>
 constexpr auto D(const Expression<E>& expr, const Variable<id>& v, Rest... rest) {
-  return D(expr.CastToUnderlying().template Derive<v>(), rest...);
+  return D(expr.CastToUnderlying().template Derive<id>(), rest...);
 }
 
 template <class E, unsigned id>
 constexpr auto D(const Expression<E>& expr, const Variable<id>& v) {
-  return expr.CastToUnderlying().template Derive<v>();
+  return expr.CastToUnderlying().template Derive<id>();
 }
 }  // namespace SymbolicMath
\ No newline at end of file
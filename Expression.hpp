@@ -31,11 +31,24 @@ class UnaryExpression : public Expression<Impl<E>> {
 
   constexpr auto Evaluate() const { return Impl<E>::func(expr.Evaluate()); }
 
+  template <class X>
+  static constexpr auto Apply(const X& x) {
+    return Impl<E>::func(x);
+  }
+
   template <class... X>
   constexpr auto operator()(const X&... x) const {
     return Impl<E>::func(expr(x...));
   }
 
+  template <class Profiler, class... X>
+  constexpr auto Profile(Profiler& profiler, const X&... x) const {
+    const auto frame = profiler.template Enter<Impl<E>>();
+    const auto output = Impl<E>::func(expr.Profile(profiler, x...));
+    profiler.Leave(frame);
+    return output;
+  }
+
   template <unsigned M>
   constexpr auto Derive() const noexcept {
     return Impl<E>::deriv(expr, expr.template Derive<M>());
@@ -70,11 +83,24 @@ class BinaryExpression : public Expression<Impl<E1, E2>> {
 
   constexpr auto Evaluate() const { return Impl<E1, E2>::func(expr1.Evaluate(), expr2.Evaluate()); }
 
+  template <class X1, class X2>
+  static constexpr auto Apply(const X1& x1, const X2& x2) {
+    return Impl<E1, E2>::func(x1, x2);
+  }
+
   template <class... X>
   constexpr auto operator()(const X&... x) const {
     return Impl<E1, E2>::func(expr1(x...), expr2(x...));
   }
 
+  template <class Profiler, class... X>
+  constexpr auto Profile(Profiler& profiler, const X&... x) const {
+    const auto frame = profiler.template Enter<Impl<E1, E2>>();
+    const auto output = Impl<E1, E2>::func(expr1.Profile(profiler, x...), expr2.Profile(profiler, x...));
+    profiler.Leave(frame);
+    return output;
+  }
+
   template <unsigned M>
   constexpr auto Derive() const noexcept {
     return Impl<E1, E2>::deriv(expr1, expr1.template Derive<M>(), expr2, expr2.template Derive<M>());
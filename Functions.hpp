@@ -17,7 +17,10 @@ class _Sin : public UnaryExpression<E, _Sin> {
   friend Base;
 
  private:  // Members
-  static constexpr auto func = [](auto x) { return std::sin(x); };
+  static constexpr auto func = [](auto x) {
+    using std::sin;
+    return sin(x);
+  };
   static constexpr auto deriv = [](auto x, auto dx) { return Cos(x) * dx; };
 
  public:  // Constructors
@@ -30,7 +33,10 @@ class _Cos : public UnaryExpression<E, _Cos> {
   friend Base;
 
  private:  // Members
-  static constexpr auto func = [](auto x) { return std::cos(x); };
+  static constexpr auto func = [](auto x) {
+    using std::cos;
+    return cos(x);
+  };
   static constexpr auto deriv = [](auto x, auto dx) { return -Sin(x) * dx; };
 
  public:  // Constructors
@@ -43,7 +49,10 @@ class _Tan : public UnaryExpression<E, _Tan> {
   friend Base;
 
  private:  // Members
-  static constexpr auto func = [](auto x) { return std::tan(x); };
+  static constexpr auto func = [](auto x) {
+    using std::tan;
+    return tan(x);
+  };
   static constexpr auto deriv = [](auto x, auto dx) { return dx / (Cos(x) * Cos(x)); };
 
  public:  // Constructors
@@ -56,8 +65,11 @@ class _Exp : public UnaryExpression<E, _Exp> {
   friend Base;
 
  private:  // Members
-  static constexpr auto func = [](auto x) { return std::exp(x); };
-  static constexpr auto deriv = [](auto x, auto dx) { return x * dx; };
+  static constexpr auto func = [](auto x) {
+    using std::exp;
+    return exp(x);
+  };
+  static constexpr auto deriv = [](auto x, auto dx) { return Exp(x) * dx; };
 
  public:  // Constructors
   constexpr _Exp(const Expression<E>& expr) noexcept : Base(expr) {}
@@ -66,21 +78,21 @@ class _Exp : public UnaryExpression<E, _Exp> {
 
 template <class Arg>
 constexpr auto Cos(const Arg& arg) {
-  return Simplify(ImplDetails::_Cos(ToExpression<Arg>(arg)));
+  return Simplify(ImplDetails::_Cos<expression_t<Arg>>(ToExpression(arg)));
 }
 
 template <class Arg>
 constexpr auto Sin(const Arg& arg) {
-  return Simplify(ImplDetails::_Sin(ToExpression<Arg>(arg)));
+  return Simplify(ImplDetails::_Sin<expression_t<Arg>>(ToExpression(arg)));
 }
 
 template <class Arg>
 constexpr auto Tan(const Arg& arg) {
-  return Simplify(ImplDetails::_Tan(ToExpression<Arg>(arg)));
+  return Simplify(ImplDetails::_Tan<expression_t<Arg>>(ToExpression(arg)));
 }
 
 template <class Arg>
 constexpr auto Exp(const Arg& arg) {
-  return Simplify(ImplDetails::_Exp(ToExpression<Arg>(arg)));
+  return Simplify(ImplDetails::_Exp<expression_t<Arg>>(ToExpression(arg)));
 }
 }  // namespace SymbolicMath
\ No newline at end of file
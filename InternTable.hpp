@@ -0,0 +1,214 @@
+#pragma once
+
+#include "Debugging.hpp"
+#include "Expression.hpp"
+
+#include "Constant.hpp"
+#include "Variable.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace SymbolicMath {
+namespace ImplDetails {
+template <class E1, class E2>
+class _Plus;
+
+template <class E1, class E2>
+class _Multiply;
+
+template <class T>
+inline constexpr char intern_tag = 0;
+
+// Every overload appends the key of its expression to key; unary and binary nodes also push their own key onto
+// subtrees, when given, after those of their operands.
+template <unsigned N>
+void AppendStructuralKey(std::string& key, const Variable<N>&, std::vector<std::string>* = nullptr) {
+  key += GetTypeName<Variable<N>>();
+}
+
+template <class T, T v>
+void AppendStructuralKey(std::string& key, const IntegralConstant<T, v>&, std::vector<std::string>* = nullptr) {
+  key += GetTypeName<IntegralConstant<T, v>>();
+}
+
+template <class T>
+void AppendStructuralKey(std::string& key, const Constant<T>& expr, std::vector<std::string>* = nullptr) {
+  static constexpr char digits[] = "0123456789abcdef";
+  const T value = expr.Evaluate();
+  unsigned char bytes[sizeof(T)];
+  std::memcpy(bytes, &value, sizeof(T));
+
+  key += GetTypeName<Constant<T>>();
+  key += '{';
+  for (auto byte : bytes)
+    key.append({digits[byte >> 4], digits[byte & 15]});
+  key += '}';
+}
+
+template <class E, template <class> class Impl>
+void AppendStructuralKey(std::string& key, const UnaryExpression<E, Impl>& expr,
+                         std::vector<std::string>* subtrees = nullptr) {
+  const auto start = key.size();
+  key += GetNodeName<Impl<E>>();
+  key += '(';
+  AppendStructuralKey(key, expr.GetSub(), subtrees);
+  key += ')';
+  if (subtrees)
+    subtrees->push_back(key.substr(start));
+}
+
+// Operands of _Plus and _Multiply are ordered by their own key, so a + b and b + a produce the same key, as
+// IsSameExpression treats them.
+template <class E1, class E2, template <class, class> class Impl>
+void AppendStructuralKey(std::string& key, const BinaryExpression<E1, E2, Impl>& expr,
+                         std::vector<std::string>* subtrees = nullptr) {
+  constexpr bool is_commutative =
+      std::is_same_v<Impl<E1, E2>, _Plus<E1, E2>> || std::is_same_v<Impl<E1, E2>, _Multiply<E1, E2>>;
+  const auto [expr1, expr2] = expr.GetSubs();
+  const auto start = key.size();
+  std::string key1, key2;
+  AppendStructuralKey(key1, expr1, subtrees);
+  AppendStructuralKey(key2, expr2, subtrees);
+  if (is_commutative && key2 < key1)
+    std::swap(key1, key2);
+
+  key += GetNodeName<Impl<E1, E2>>();
+  key += '(';
+  key += key1;
+  key += ',';
+  key += key2;
+  key += ')';
+  if (subtrees)
+    subtrees->push_back(key.substr(start));
+}
+
+struct InternEntry {
+  std::uint64_t id;
+  std::vector<std::pair<const void*, std::shared_ptr<const void>>> instances;
+};
+
+struct InternShard {
+  mutable std::shared_mutex mutex;
+  std::unordered_map<std::string, InternEntry> entries;
+};
+}  // namespace ImplDetails
+
+// Canonical key of an expression: two expressions have the same key exactly when IsSameExpression holds for their
+// types, with operands of _Plus and _Multiply in either order, and all their runtime constants are bitwise equal.
+template <class E>
+std::string GetStructuralKey(const Expression<E>& expr) {
+  std::string key;
+  ImplDetails::AppendStructuralKey(key, expr.CastToUnderlying());
+  return key;
+}
+
+template <class E>
+struct Interned {
+  // Same for all structurally equal expressions, whatever their operand order; usable as a memoization key.
+  std::uint64_t id;
+  // The single shared instance of this expression type within its equivalence class.
+  std::shared_ptr<const E> expr;
+};
+
+// Thread safe hash-consing table. Keys are spread over shards by hash and each shard is guarded by its own
+// reader-writer lock, so lookups of already interned expressions from many threads only take shared locks.
+// Interning an expression also assigns ids to all of its unary and binary subtrees, so results computed for a
+// subtree can be memoized under GetId of that subtree.
+class InternTable {
+ private:  // Members
+  std::vector<ImplDetails::InternShard> shards;
+  std::atomic<std::uint64_t> next_id{0};
+
+ public:  // Constructors
+  explicit InternTable(std::size_t shard_count = 64) : shards(shard_count ? shard_count : 1) {}
+
+ public:  // Methods
+  template <class E>
+  Interned<E> Intern(const Expression<E>& expr) {
+    auto key = RegisterSubtrees(expr);
+    auto& shard = GetShard(key);
+    const void* tag = &ImplDetails::intern_tag<E>;
+
+    {
+      std::shared_lock lock(shard.mutex);
+      if (auto found = shard.entries.find(key); found != shard.entries.end())
+        for (const auto& [instance_tag, instance] : found->second.instances)
+          if (instance_tag == tag)
+            return {found->second.id, std::static_pointer_cast<const E>(instance)};
+    }
+
+    std::unique_lock lock(shard.mutex);
+    auto [found, inserted] = shard.entries.try_emplace(std::move(key));
+    auto& entry = found->second;
+    if (inserted)
+      entry.id = next_id.fetch_add(1, std::memory_order_relaxed);
+    for (const auto& [instance_tag, instance] : entry.instances)
+      if (instance_tag == tag)
+        return {entry.id, std::static_pointer_cast<const E>(instance)};
+
+    auto instance = std::make_shared<const E>(expr.CastToUnderlying());
+    entry.instances.emplace_back(tag, instance);
+    return {entry.id, std::move(instance)};
+  }
+
+  // Id of the equivalence class of expr, the same as Intern(expr).id, without keeping an instance of expr.
+  template <class E>
+  std::uint64_t GetId(const Expression<E>& expr) {
+    return Register(RegisterSubtrees(expr));
+  }
+
+  // Number of distinct equivalence classes interned so far, subtrees included.
+  std::size_t Size() const {
+    std::size_t size = 0;
+    for (const auto& shard : shards) {
+      std::shared_lock lock(shard.mutex);
+      size += shard.entries.size();
+    }
+    return size;
+  }
+
+ private:  // Methods
+  ImplDetails::InternShard& GetShard(const std::string& key) {
+    return shards[std::hash<std::string>{}(key) % shards.size()];
+  }
+
+  std::uint64_t Register(std::string key) {
+    auto& shard = GetShard(key);
+    {
+      std::shared_lock lock(shard.mutex);
+      if (auto found = shard.entries.find(key); found != shard.entries.end())
+        return found->second.id;
+    }
+
+    std::unique_lock lock(shard.mutex);
+    auto [found, inserted] = shard.entries.try_emplace(std::move(key));
+    if (inserted)
+      found->second.id = next_id.fetch_add(1, std::memory_order_relaxed);
+    return found->second.id;
+  }
+
+  // Registers every proper subtree of expr, innermost first, and returns the key of expr itself.
+  template <class E>
+  std::string RegisterSubtrees(const Expression<E>& expr) {
+    std::string key;
+    std::vector<std::string> subtrees;
+    ImplDetails::AppendStructuralKey(key, expr.CastToUnderlying(), &subtrees);
+    if (!subtrees.empty() && subtrees.back() == key)
+      subtrees.pop_back();
+    for (auto& subtree : subtrees)
+      Register(std::move(subtree));
+    return key;
+  }
+};
+}  // namespace SymbolicMath
\ No newline at end of file
@@ -0,0 +1,215 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace SymbolicMath::ImplDetails {
+// One flag per lane of a LaneBlock<T, W>, the result of a lane-wise comparison. Flags are integers as wide as T,
+// all bits set or clear, rather than bool, so comparisons and Select vectorize as compare and blend instructions.
+template <class T, std::size_t W>
+struct LaneMask {
+  using lane_t = std::conditional_t<sizeof(T) <= sizeof(std::int32_t), std::int32_t, std::int64_t>;
+
+  std::array<lane_t, W> lanes;
+
+  // Methods
+  constexpr bool operator[](std::size_t lane) const noexcept { return lanes[lane] != 0; }
+
+  constexpr void Set(std::size_t lane, bool value) noexcept { lanes[lane] = value ? ~lane_t(0) : lane_t(0); }
+
+  friend constexpr LaneMask operator&(const LaneMask& a, const LaneMask& b) noexcept {
+    LaneMask result;
+    for (std::size_t lane = 0; lane < W; ++lane)
+      result.lanes[lane] = a.lanes[lane] & b.lanes[lane];
+    return result;
+  }
+
+  friend constexpr LaneMask operator|(const LaneMask& a, const LaneMask& b) noexcept {
+    LaneMask result;
+    for (std::size_t lane = 0; lane < W; ++lane)
+      result.lanes[lane] = a.lanes[lane] | b.lanes[lane];
+    return result;
+  }
+
+  friend constexpr LaneMask operator!(const LaneMask& a) noexcept {
+    LaneMask result;
+    for (std::size_t lane = 0; lane < W; ++lane)
+      result.lanes[lane] = ~a.lanes[lane];
+    return result;
+  }
+};
+
+// W values of T stored side by side, structure of arrays style. Arithmetic and the functions used by the expression
+// nodes apply lane by lane as fixed trip count loops the compiler vectorizes, so evaluating an expression at a
+// LaneBlock evaluates it at W points in one pass. The operators and functions are hidden friends: lookup finds them
+// only through a LaneBlock argument, where they are preferred over the generic expression operators.
+template <class T, std::size_t W>
+struct LaneBlock {
+  static_assert(std::is_floating_point_v<T> && W > 0);
+
+  std::array<T, W> lanes;
+
+  // Constructors
+  LaneBlock() = default;
+
+  template <class S, class = std::enable_if_t<std::is_arithmetic_v<S>>>
+  constexpr explicit LaneBlock(const S& value) noexcept {
+    for (auto& lane : lanes)
+      lane = static_cast<T>(value);
+  }
+
+  // Methods
+  constexpr const T& operator[](std::size_t lane) const noexcept { return lanes[lane]; }
+  constexpr T& operator[](std::size_t lane) noexcept { return lanes[lane]; }
+
+  template <class F>
+  friend constexpr LaneBlock Map(const LaneBlock& a, const F& func) {
+    LaneBlock result;
+    for (std::size_t lane = 0; lane < W; ++lane)
+      result[lane] = func(a[lane]);
+    return result;
+  }
+
+  template <class F>
+  friend constexpr LaneBlock Map(const LaneBlock& a, const LaneBlock& b, const F& func) {
+    LaneBlock result;
+    for (std::size_t lane = 0; lane < W; ++lane)
+      result[lane] = func(a[lane], b[lane]);
+    return result;
+  }
+
+  friend constexpr LaneBlock operator-(const LaneBlock& a) noexcept {
+    return Map(a, [](T x) { return -x; });
+  }
+
+  friend constexpr LaneBlock operator+(const LaneBlock& a, const LaneBlock& b) noexcept {
+    return Map(a, b, [](T x, T y) { return x + y; });
+  }
+
+  friend constexpr LaneBlock operator-(const LaneBlock& a, const LaneBlock& b) noexcept {
+    return Map(a, b, [](T x, T y) { return x - y; });
+  }
+
+  friend constexpr LaneBlock operator*(const LaneBlock& a, const LaneBlock& b) noexcept {
+    return Map(a, b, [](T x, T y) { return x * y; });
+  }
+
+  friend constexpr LaneBlock operator/(const LaneBlock& a, const LaneBlock& b) noexcept {
+    return Map(a, b, [](T x, T y) { return x / y; });
+  }
+
+  // Scalars, e.g. the values of IntegralConstant and Constant leaves, are broadcast to every lane.
+  template <class S>
+  friend constexpr std::enable_if_t<std::is_arithmetic_v<S>, LaneBlock> operator+(const LaneBlock& a, const S& b) {
+    return a + LaneBlock(b);
+  }
+
+  template <class S>
+  friend constexpr std::enable_if_t<std::is_arithmetic_v<S>, LaneBlock> operator+(const S& a, const LaneBlock& b) {
+    return LaneBlock(a) + b;
+  }
+
+  template <class S>
+  friend constexpr std::enable_if_t<std::is_arithmetic_v<S>, LaneBlock> operator-(const LaneBlock& a, const S& b) {
+    return a - LaneBlock(b);
+  }
+
+  template <class S>
+  friend constexpr std::enable_if_t<std::is_arithmetic_v<S>, LaneBlock> operator-(const S& a, const LaneBlock& b) {
+    return LaneBlock(a) - b;
+  }
+
+  template <class S>
+  friend constexpr std::enable_if_t<std::is_arithmetic_v<S>, LaneBlock> operator*(const LaneBlock& a, const S& b) {
+    return a * LaneBlock(b);
+  }
+
+  template <class S>
+  friend constexpr std::enable_if_t<std::is_arithmetic_v<S>, LaneBlock> operator*(const S& a, const LaneBlock& b) {
+    return LaneBlock(a) * b;
+  }
+
+  template <class S>
+  friend constexpr std::enable_if_t<std::is_arithmetic_v<S>, LaneBlock> operator/(const LaneBlock& a, const S& b) {
+    return a / LaneBlock(b);
+  }
+
+  template <class S>
+  friend constexpr std::enable_if_t<std::is_arithmetic_v<S>, LaneBlock> operator/(const S& a, const LaneBlock& b) {
+    return LaneBlock(a) / b;
+  }
+
+  friend constexpr LaneMask<T, W> operator<(const LaneBlock& a, const LaneBlock& b) noexcept {
+    using lane_t = typename LaneMask<T, W>::lane_t;
+    LaneMask<T, W> result;
+    for (std::size_t lane = 0; lane < W; ++lane)
+      result.lanes[lane] = a[lane] < b[lane] ? ~lane_t(0) : lane_t(0);
+    return result;
+  }
+
+  friend constexpr LaneMask<T, W> operator<=(const LaneBlock& a, const LaneBlock& b) noexcept {
+    using lane_t = typename LaneMask<T, W>::lane_t;
+    LaneMask<T, W> result;
+    for (std::size_t lane = 0; lane < W; ++lane)
+      result.lanes[lane] = a[lane] <= b[lane] ? ~lane_t(0) : lane_t(0);
+    return result;
+  }
+
+  friend LaneBlock abs(const LaneBlock& a) {
+    return Map(a, [](T x) { return std::abs(x); });
+  }
+
+  friend LaneBlock sin(const LaneBlock& a) {
+    return Map(a, [](T x) { return std::sin(x); });
+  }
+
+  friend LaneBlock cos(const LaneBlock& a) {
+    return Map(a, [](T x) { return std::cos(x); });
+  }
+
+  friend LaneBlock tan(const LaneBlock& a) {
+    return Map(a, [](T x) { return std::tan(x); });
+  }
+
+  friend LaneBlock exp(const LaneBlock& a) {
+    return Map(a, [](T x) { return std::exp(x); });
+  }
+
+  friend constexpr LaneBlock max(const LaneBlock& a, const LaneBlock& b) noexcept {
+    return Map(a, b, [](T x, T y) { return x < y ? y : x; });
+  }
+};
+
+// Lane-wise a where mask is set and b elsewhere, as a bitwise blend so that it vectorizes. A single lane is better
+// served by a branch, and so is long double, which has no integer type of its width to blend through.
+template <class T, std::size_t W>
+LaneBlock<T, W> Select(const LaneMask<T, W>& mask, const LaneBlock<T, W>& a, const LaneBlock<T, W>& b) noexcept {
+  using lane_t = typename LaneMask<T, W>::lane_t;
+  LaneBlock<T, W> result;
+  if constexpr (W == 1 || sizeof(T) != sizeof(lane_t)) {
+    for (std::size_t lane = 0; lane < W; ++lane)
+      result[lane] = mask[lane] ? a[lane] : b[lane];
+  } else {
+    for (std::size_t lane = 0; lane < W; ++lane) {
+      lane_t if_set, if_clear;
+      std::memcpy(&if_set, &a[lane], sizeof(T));
+      std::memcpy(&if_clear, &b[lane], sizeof(T));
+      const lane_t bits = (if_set & mask.lanes[lane]) | (if_clear & ~mask.lanes[lane]);
+      std::memcpy(&result[lane], &bits, sizeof(T));
+    }
+  }
+  return result;
+}
+
+template <class T, std::size_t W>
+constexpr bool Any(const LaneMask<T, W>& mask) noexcept {
+  typename LaneMask<T, W>::lane_t any = 0;
+  for (std::size_t lane = 0; lane < W; ++lane)
+    any |= mask.lanes[lane];
+  return any != 0;
+}
+}  // namespace SymbolicMath::ImplDetails
\ No newline at end of file
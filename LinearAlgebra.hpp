@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Lanes.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+
+namespace SymbolicMath::ImplDetails {
+// Solves a * x = b in place by Gaussian elimination with partial pivoting, leaving x in b.
+// Returns false if a is numerically singular.
+template <class T, std::size_t N>
+constexpr bool SolveDense(std::array<std::array<T, N>, N>& a, std::array<T, N>& b) noexcept {
+  for (std::size_t k = 0; k < N; ++k) {
+    std::size_t pivot = k;
+    for (std::size_t i = k + 1; i < N; ++i)
+      if (std::abs(a[i][k]) > std::abs(a[pivot][k]))
+        pivot = i;
+    if (a[pivot][k] == T(0))
+      return false;
+    if (pivot != k) {
+      std::swap(a[pivot], a[k]);
+      std::swap(b[pivot], b[k]);
+    }
+
+    for (std::size_t i = k + 1; i < N; ++i) {
+      const T factor = a[i][k] / a[k][k];
+      for (std::size_t j = k + 1; j < N; ++j)
+        a[i][j] -= factor * a[k][j];
+      b[i] -= factor * b[k];
+    }
+  }
+
+  for (std::size_t k = N; k-- > 0;) {
+    T sum = b[k];
+    for (std::size_t j = k + 1; j < N; ++j)
+      sum -= a[k][j] * b[j];
+    b[k] = sum / a[k][k];
+  }
+  return true;
+}
+
+// SolveDense on W independent systems at once, one per lane. Rows are swapped lane by lane with Select so every lane
+// gets its own partial pivoting. Returns the mask of lanes whose matrix was not numerically singular; the other
+// lanes of b hold garbage.
+template <class T, std::size_t W, std::size_t N>
+constexpr LaneMask<T, W> SolveDense(std::array<std::array<LaneBlock<T, W>, N>, N>& a,
+                                    std::array<LaneBlock<T, W>, N>& b) noexcept {
+  using block_t = LaneBlock<T, W>;
+  const block_t zero(0);
+  LaneMask<T, W> singular{};
+  for (std::size_t k = 0; k < N; ++k) {
+    for (std::size_t i = k + 1; i < N; ++i) {
+      const auto swap = abs(a[k][k]) < abs(a[i][k]);
+      for (std::size_t j = k; j < N; ++j) {
+        const block_t top = a[k][j];
+        a[k][j] = Select(swap, a[i][j], top);
+        a[i][j] = Select(swap, top, a[i][j]);
+      }
+      const block_t top = b[k];
+      b[k] = Select(swap, b[i], top);
+      b[i] = Select(swap, top, b[i]);
+    }
+    singular = singular | (abs(a[k][k]) <= zero);
+
+    for (std::size_t i = k + 1; i < N; ++i) {
+      const block_t factor = a[i][k] / a[k][k];
+      for (std::size_t j = k + 1; j < N; ++j)
+        a[i][j] = a[i][j] - factor * a[k][j];
+      b[i] = b[i] - factor * b[k];
+    }
+  }
+
+  for (std::size_t k = N; k-- > 0;) {
+    block_t sum = b[k];
+    for (std::size_t j = k + 1; j < N; ++j)
+      sum = sum - a[k][j] * b[j];
+    b[k] = sum / a[k][k];
+  }
+  return !singular;
+}
+}  // namespace SymbolicMath::ImplDetails
\ No newline at end of file
@@ -0,0 +1,383 @@
+#pragma once
+
+#include "Expression.hpp"
+
+#include "Constant.hpp"
+#include "Simplifier.hpp"
+#include "Variable.hpp"
+
+#include "LinearAlgebra.hpp"
+#include "Parallel.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace SymbolicMath {
+template <class E>
+constexpr bool is_structural_zero_v = false;
+
+template <class T, T v>
+constexpr bool is_structural_zero_v<IntegralConstant<T, v>> = v == 0;
+
+namespace ImplDetails {
+template <class E, class T, std::size_t N, std::size_t... I>
+constexpr T EvaluateAt(const E& expr, const std::array<T, N>& y, std::index_sequence<I...>) {
+  return static_cast<T>(expr(y[I]...));
+}
+
+template <class E, unsigned... J>
+constexpr auto MakeJacobianRow(const E& expr, std::integer_sequence<unsigned, J...>) {
+  return std::make_tuple(expr.template Derive<J>()...);
+}
+
+template <class Jacobian, std::size_t N, std::size_t... K>
+constexpr std::array<bool, N * N> MakeSparsityPattern(std::index_sequence<K...>) noexcept {
+  return {!is_structural_zero_v<std::tuple_element_t<K % N, std::tuple_element_t<K / N, Jacobian>>>...};
+}
+
+template <std::size_t N>
+constexpr std::size_t CountNonzeros(const std::array<bool, N * N>& pattern) noexcept {
+  std::size_t count = 0;
+  for (auto nonzero : pattern)
+    count += nonzero;
+  return count;
+}
+
+template <std::size_t N>
+constexpr std::array<std::size_t, N + 1> MakeRowOffsets(const std::array<bool, N * N>& pattern) noexcept {
+  std::array<std::size_t, N + 1> offsets{};
+  for (std::size_t i = 0; i < N; ++i) {
+    offsets[i + 1] = offsets[i];
+    for (std::size_t j = 0; j < N; ++j)
+      offsets[i + 1] += pattern[i * N + j];
+  }
+  return offsets;
+}
+
+template <std::size_t N, std::size_t NNZ>
+constexpr std::array<unsigned, NNZ> MakeColumns(const std::array<bool, N * N>& pattern) noexcept {
+  std::array<unsigned, NNZ> columns{};
+  std::size_t slot = 0;
+  for (std::size_t k = 0; k < N * N; ++k)
+    if (pattern[k])
+      columns[slot++] = static_cast<unsigned>(k % N);
+  return columns;
+}
+
+template <class... Rows>
+auto FlattenRows(const std::tuple<Rows...>&) -> decltype(std::tuple_cat(std::declval<Rows>()...));
+
+template <class... T>
+struct TypeList {};
+
+// Passes a type to a generic lambda as a value.
+template <class T>
+struct TypeTag {
+  using type = T;
+};
+
+template <class T, class List>
+constexpr bool is_listed_v = false;
+
+template <class T, class... L>
+constexpr bool is_listed_v<T, TypeList<L...>> = (std::is_same_v<T, L> || ...);
+
+template <class T, class List>
+constexpr std::size_t list_index_v = 0;
+
+template <class T, class L0, class... L>
+constexpr std::size_t list_index_v<T, TypeList<L0, L...>> =
+    std::is_same_v<T, L0> ? 0 : 1 + list_index_v<T, TypeList<L...>>;
+
+template <class List, class T, bool = is_listed_v<T, List>>
+struct Append {
+  using type = List;
+};
+
+template <class... L, class T>
+struct Append<TypeList<L...>, T, false> {
+  using type = TypeList<L..., T>;
+};
+
+template <class E>
+constexpr bool is_unary_node_v = false;
+
+template <class S, template <class> class Unary>
+constexpr bool is_unary_node_v<Unary<S>> = std::is_base_of_v<Expression<S>, S>;
+
+template <class E>
+constexpr bool is_binary_node_v = false;
+
+template <class S1, class S2, template <class, class> class Binary>
+constexpr bool is_binary_node_v<Binary<S1, S2>> =
+    std::is_base_of_v<Expression<S1>, S1> && std::is_base_of_v<Expression<S2>, S2>;
+
+// Appends to List, children first, every unary and binary subtree of E that is fully determined by its type.
+// Subtrees holding a runtime Constant are skipped: two of them can share a type and still differ in value.
+template <class E, class List>
+struct CollectSubexpressions {
+  using type = List;
+};
+
+template <class S, template <class> class Unary, class List>
+struct CollectSubexpressions<Unary<S>, List> {
+  using sub_t = typename CollectSubexpressions<S, List>::type;
+  using type = std::conditional_t<is_unary_node_v<Unary<S>> && Unary<S>::is_constexpr_v,
+                                  typename Append<sub_t, Unary<S>>::type, sub_t>;
+};
+
+template <class S1, class S2, template <class, class> class Binary, class List>
+struct CollectSubexpressions<Binary<S1, S2>, List> {
+  using sub_t = typename CollectSubexpressions<S2, typename CollectSubexpressions<S1, List>::type>::type;
+  using type = std::conditional_t<is_binary_node_v<Binary<S1, S2>> && Binary<S1, S2>::is_constexpr_v,
+                                  typename Append<sub_t, Binary<S1, S2>>::type, sub_t>;
+};
+
+template <class List, class Tuple>
+struct CollectTuple;
+
+template <class List>
+struct CollectTuple<List, std::tuple<>> {
+  using type = List;
+};
+
+template <class List, class E0, class... E>
+struct CollectTuple<List, std::tuple<E0, E...>> {
+  using type = typename CollectTuple<typename CollectSubexpressions<E0, List>::type, std::tuple<E...>>::type;
+};
+
+// Value of a leaf, or of a listed subtree taken from the cache.
+template <class S, class List, class T, std::size_t M, std::size_t N>
+constexpr T CachedValue(const std::array<T, M>& cache, const std::array<T, N>& y) {
+  if constexpr (is_listed_v<S, List>)
+    return cache[list_index_v<S, List>];
+  else
+    return EvaluateAt(S{}, y, std::make_index_sequence<N>{});
+}
+
+// Evaluates every subtree of List once, in order, each from the already evaluated values of its children.
+template <class... L, class T, std::size_t N>
+constexpr std::array<T, sizeof...(L)> EvaluateSubexpressions(TypeList<L...>, const std::array<T, N>& y) {
+  using list_t = TypeList<L...>;
+  std::array<T, sizeof...(L)> cache{};
+  [[maybe_unused]] const auto evaluate = [&](auto tag) {
+    using S = typename decltype(tag)::type;
+    if constexpr (is_unary_node_v<S>)
+      return static_cast<T>(S::Apply(CachedValue<nth_parameter_t<0, S>, list_t>(cache, y)));
+    else
+      return static_cast<T>(S::Apply(CachedValue<nth_parameter_t<0, S>, list_t>(cache, y),
+                                     CachedValue<nth_parameter_t<1, S>, list_t>(cache, y)));
+  };
+  ((cache[list_index_v<L, list_t>] = evaluate(TypeTag<L>{})), ...);
+  return cache;
+}
+
+// Evaluates expr like expr(y...), reading every listed subtree from the cache instead of recomputing it.
+template <class List, class E, class T, std::size_t M, std::size_t N>
+constexpr T EvaluateCached(const E& expr, const std::array<T, M>& cache, const std::array<T, N>& y) {
+  if constexpr (is_listed_v<E, List>) {
+    return cache[list_index_v<E, List>];
+  } else if constexpr (is_unary_node_v<E>) {
+    return static_cast<T>(E::Apply(EvaluateCached<List>(expr.GetSub(), cache, y)));
+  } else if constexpr (is_binary_node_v<E>) {
+    const auto [expr1, expr2] = expr.GetSubs();
+    return static_cast<T>(E::Apply(EvaluateCached<List>(expr1, cache, y), EvaluateCached<List>(expr2, cache, y)));
+  } else {
+    return EvaluateAt(expr, y, std::make_index_sequence<N>{});
+  }
+}
+}  // namespace ImplDetails
+
+// Autonomous system y' = f(y) where the i-th expression is f_i over Variable<0>..Variable<N-1>.
+// The Jacobian is derived symbolically once on construction; entries that simplify to an integral zero
+// are structural zeros and define the compressed sparse row pattern of EvaluateSparse.
+// Each evaluation first computes every distinct subtree shared by f and the Jacobian once, then assembles the
+// entries from those values, so e.g. Exp(x) in f and in df/dx is evaluated a single time.
+template <class... E>
+class OdeSystem {
+  static_assert(sizeof...(E) > 0);
+
+ public:  // Members
+  static constexpr unsigned size = sizeof...(E);
+
+ private:  // Aliases
+  using indexes_t = std::make_integer_sequence<unsigned, size>;
+  using state_indexes_t = std::make_index_sequence<size>;
+  using entry_indexes_t = std::make_index_sequence<size * size>;
+  using jacobian_t = std::tuple<decltype(ImplDetails::MakeJacobianRow(std::declval<E>(), indexes_t{}))...>;
+  using rhs_subexpressions_t = typename ImplDetails::CollectTuple<ImplDetails::TypeList<>, std::tuple<E...>>::type;
+  using subexpressions_t = typename ImplDetails::CollectTuple<
+      rhs_subexpressions_t, decltype(ImplDetails::FlattenRows(std::declval<jacobian_t>()))>::type;
+
+ public:  // Members
+  static constexpr std::array<bool, size * size> pattern =
+      ImplDetails::MakeSparsityPattern<jacobian_t, size>(entry_indexes_t{});
+  static constexpr std::size_t nonzeros = ImplDetails::CountNonzeros<size>(pattern);
+  static constexpr std::array<std::size_t, size + 1> row_offsets = ImplDetails::MakeRowOffsets<size>(pattern);
+  static constexpr std::array<unsigned, nonzeros> columns = ImplDetails::MakeColumns<size, nonzeros>(pattern);
+
+ private:  // Members
+  const std::tuple<E...> rhs;
+  const jacobian_t jacobian;
+
+ public:  // Constructors
+  constexpr OdeSystem(const Expression<E>&... exprs)
+      : rhs(exprs.CastToUnderlying()...),
+        jacobian(ImplDetails::MakeJacobianRow(exprs.CastToUnderlying(), indexes_t{})...) {}
+
+ public:  // Methods
+  constexpr auto GetRhs() const noexcept { return rhs; }
+
+  constexpr auto GetJacobian() const noexcept { return jacobian; }
+
+  template <class T>
+  constexpr void Rhs(const std::array<T, size>& y, std::array<T, size>& f) const {
+    const auto cache = ImplDetails::EvaluateSubexpressions(rhs_subexpressions_t{}, y);
+    RhsImpl<rhs_subexpressions_t>(y, cache, f, state_indexes_t{});
+  }
+
+  template <class T>
+  constexpr void Jacobian(const std::array<T, size>& y, std::array<std::array<T, size>, size>& jac) const {
+    const auto cache = ImplDetails::EvaluateSubexpressions(subexpressions_t{}, y);
+    JacobianImpl(y, cache, jac, entry_indexes_t{});
+  }
+
+  // f and the dense row-major Jacobian from one set of shared subexpression values.
+  template <class T>
+  constexpr void Evaluate(const std::array<T, size>& y, std::array<T, size>& f,
+                          std::array<std::array<T, size>, size>& jac) const {
+    const auto cache = ImplDetails::EvaluateSubexpressions(subexpressions_t{}, y);
+    RhsImpl<subexpressions_t>(y, cache, f, state_indexes_t{});
+    JacobianImpl(y, cache, jac, entry_indexes_t{});
+  }
+
+  // f and the structurally nonzero Jacobian entries, in the order given by row_offsets/columns, from one set of
+  // shared subexpression values.
+  template <class T>
+  constexpr void EvaluateSparse(const std::array<T, size>& y, std::array<T, size>& f,
+                                std::array<T, nonzeros>& values) const {
+    const auto cache = ImplDetails::EvaluateSubexpressions(subexpressions_t{}, y);
+    RhsImpl<subexpressions_t>(y, cache, f, state_indexes_t{});
+    SparseImpl(y, cache, values, entry_indexes_t{});
+  }
+
+ private:  // Methods
+  template <class List, class T, class Cache, std::size_t... I>
+  constexpr void RhsImpl(const std::array<T, size>& y, const Cache& cache, std::array<T, size>& f,
+                         std::index_sequence<I...>) const {
+    ((f[I] = ImplDetails::EvaluateCached<List>(std::get<I>(rhs), cache, y)), ...);
+  }
+
+  template <class T, class Cache, std::size_t... K>
+  constexpr void JacobianImpl(const std::array<T, size>& y, const Cache& cache,
+                              std::array<std::array<T, size>, size>& jac, std::index_sequence<K...>) const {
+    ((jac[K / size][K % size] = ImplDetails::EvaluateCached<subexpressions_t>(
+          std::get<K % size>(std::get<K / size>(jacobian)), cache, y)),
+     ...);
+  }
+
+  template <class T, class Cache, std::size_t... K>
+  constexpr void SparseImpl(const std::array<T, size>& y, const Cache& cache, std::array<T, nonzeros>& values,
+                            std::index_sequence<K...>) const {
+    (StoreSparse<K>(y, cache, values), ...);
+  }
+
+  template <std::size_t K, class T, class Cache>
+  constexpr void StoreSparse(const std::array<T, size>& y, const Cache& cache, std::array<T, nonzeros>& values) const {
+    if constexpr (pattern[K]) {
+      constexpr std::size_t slot = ImplDetails::CountNonzeros<size>(PrefixPattern<K>());
+      values[slot] =
+          ImplDetails::EvaluateCached<subexpressions_t>(std::get<K % size>(std::get<K / size>(jacobian)), cache, y);
+    }
+  }
+
+  template <std::size_t K>
+  static constexpr std::array<bool, size * size> PrefixPattern() noexcept {
+    std::array<bool, size * size> prefix{};
+    for (std::size_t k = 0; k < K; ++k)
+      prefix[k] = pattern[k];
+    return prefix;
+  }
+};
+
+// Advances every state by `steps` classical Runge-Kutta steps of size dt, splitting the batch over `threads`.
+template <class... E, class T, std::size_t N>
+void StepRK4Batch(const OdeSystem<E...>& system, std::vector<std::array<T, N>>& states, T dt, unsigned steps = 1,
+                  unsigned threads = 1) {
+  static_assert(N == OdeSystem<E...>::size);
+  ImplDetails::ParallelFor(states.size(), threads, [&](std::size_t begin, std::size_t end) {
+    std::array<T, N> k1, k2, k3, k4, tmp;
+    for (std::size_t lane = begin; lane < end; ++lane) {
+      auto& y = states[lane];
+      for (unsigned step = 0; step < steps; ++step) {
+        system.Rhs(y, k1);
+        for (std::size_t i = 0; i < N; ++i)
+          tmp[i] = y[i] + dt / 2 * k1[i];
+        system.Rhs(tmp, k2);
+        for (std::size_t i = 0; i < N; ++i)
+          tmp[i] = y[i] + dt / 2 * k2[i];
+        system.Rhs(tmp, k3);
+        for (std::size_t i = 0; i < N; ++i)
+          tmp[i] = y[i] + dt * k3[i];
+        system.Rhs(tmp, k4);
+        for (std::size_t i = 0; i < N; ++i)
+          y[i] += dt / 6 * (k1[i] + 2 * k2[i] + 2 * k3[i] + k4[i]);
+      }
+    }
+  });
+}
+
+// Advances every state by `steps` backward Euler steps of size dt. Each step solves z - y - dt * f(z) = 0 with
+// Newton iterations on the f/Jacobian kernel until the update drops below tolerance * (1 + max|z|).
+// A lane whose Newton iteration fails to converge, or hits a singular matrix, keeps its last accepted state and
+// takes no further steps. Returns one flag per lane, nonzero for the lanes that failed.
+template <class... E, class T, std::size_t N>
+std::vector<unsigned char> StepImplicitEulerBatch(const OdeSystem<E...>& system,
+                                                  std::vector<std::array<T, N>>& states, T dt, unsigned steps = 1,
+                                                  unsigned threads = 1, unsigned max_iterations = 10,
+                                                  T tolerance = std::sqrt(std::numeric_limits<T>::epsilon())) {
+  static_assert(N == OdeSystem<E...>::size);
+  std::vector<unsigned char> failed(states.size(), 0);
+  ImplDetails::ParallelFor(states.size(), threads, [&](std::size_t begin, std::size_t end) {
+    std::array<T, N> z, f, delta;
+    std::array<std::array<T, N>, N> jac;
+    for (std::size_t lane = begin; lane < end; ++lane) {
+      auto& y = states[lane];
+      for (unsigned step = 0; step < steps && !failed[lane]; ++step) {
+        z = y;
+        bool converged = false;
+        for (unsigned iteration = 0; iteration < max_iterations && !converged; ++iteration) {
+          system.Evaluate(z, f, jac);
+          for (std::size_t i = 0; i < N; ++i) {
+            delta[i] = z[i] - y[i] - dt * f[i];
+            for (std::size_t j = 0; j < N; ++j)
+              jac[i][j] = (i == j ? T(1) : T(0)) - dt * jac[i][j];
+          }
+          if (!ImplDetails::SolveDense(jac, delta))
+            break;
+
+          T update = 0, scale = 0;
+          for (std::size_t i = 0; i < N; ++i) {
+            z[i] -= delta[i];
+            update = std::max(update, std::abs(delta[i]));
+            scale = std::max(scale, std::abs(z[i]));
+          }
+          converged = update <= tolerance * (1 + scale);
+        }
+        if (converged)
+          y = z;
+        else
+          failed[lane] = 1;
+      }
+    }
+  });
+  return failed;
+}
+}  // namespace SymbolicMath
\ No newline at end of file
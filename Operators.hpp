@@ -73,28 +73,41 @@ class _Divide : public BinaryExpression<E1, E2, _Divide> {
 };
 }  // namespace ImplDetails
 
+// These operators accept any argument types, and argument dependent lookup finds them for every type with
+// SymbolicMath as an associated namespace. That includes standard types instantiated over a SymbolicMath class,
+// e.g. the iterators of std::vector<T>, where they then hijack iterator arithmetic. Helper structs that end up in
+// such containers are therefore declared in ImplDetails: the associated namespace of a class is only its innermost
+// enclosing namespace, so lookup never reaches these operators.
 template <class Arg>
 constexpr auto operator-(const Arg& arg) {
-  return Simplify(ImplDetails::_Negate(ToExpression(arg)));
+  return Simplify(ImplDetails::_Negate<expression_t<Arg>>(ToExpression(arg)));
 }
 
 template <class Arg1, class Arg2>
 constexpr auto operator+(const Arg1& arg1, const Arg2& arg2) {
-  return Simplify(ImplDetails::_Plus(ToExpression(arg1), ToExpression(arg2)));
+  using E1 = expression_t<Arg1>;
+  using E2 = expression_t<Arg2>;
+  return Simplify(ImplDetails::_Plus<E1, E2>(ToExpression(arg1), ToExpression(arg2)));
 }
 
 template <class Arg1, class Arg2>
 constexpr auto operator-(const Arg1& arg1, const Arg2& arg2) {
-  return Simplify(ImplDetails::_Minus(ToExpression(arg1), ToExpression(arg2)));
+  using E1 = expression_t<Arg1>;
+  using E2 = expression_t<Arg2>;
+  return Simplify(ImplDetails::_Minus<E1, E2>(ToExpression(arg1), ToExpression(arg2)));
 }
 
 template <class Arg1, class Arg2>
 constexpr auto operator*(const Arg1& arg1, const Arg2& arg2) {
-  return Simplify(ImplDetails::_Multiply(ToExpression(arg1), ToExpression(arg2)));
+  using E1 = expression_t<Arg1>;
+  using E2 = expression_t<Arg2>;
+  return Simplify(ImplDetails::_Multiply<E1, E2>(ToExpression(arg1), ToExpression(arg2)));
 }
 
 template <class Arg1, class Arg2>
 constexpr auto operator/(const Arg1& arg1, const Arg2& arg2) {
-  return Simplify(ImplDetails::_Divide(ToExpression(arg1), ToExpression(arg2)));
+  using E1 = expression_t<Arg1>;
+  using E2 = expression_t<Arg2>;
+  return Simplify(ImplDetails::_Divide<E1, E2>(ToExpression(arg1), ToExpression(arg2)));
 }
 }  // namespace SymbolicMath
\ No newline at end of file
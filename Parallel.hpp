@@ -0,0 +1,33 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace SymbolicMath::ImplDetails {
+// Splits [0, count) into contiguous chunks and runs func(begin, end) for each on its own thread.
+// threads == 0 selects std::thread::hardware_concurrency().
+template <class F>
+void ParallelFor(std::size_t count, unsigned threads, const F& func) {
+  if (threads == 0)
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  threads = static_cast<unsigned>(std::min<std::size_t>(threads, count));
+  if (threads <= 1) {
+    func(std::size_t(0), count);
+    return;
+  }
+
+  std::vector<std::thread> workers;
+  workers.reserve(threads - 1);
+  const std::size_t chunk = (count + threads - 1) / threads;
+  for (unsigned t = 1; t < threads; ++t) {
+    const std::size_t begin = std::min(count, t * chunk);
+    const std::size_t end = std::min(count, begin + chunk);
+    workers.emplace_back([&func, begin, end] { func(begin, end); });
+  }
+  func(std::size_t(0), std::min(count, chunk));
+  for (auto& worker : workers)
+    worker.join();
+}
+}  // namespace SymbolicMath::ImplDetails
\ No newline at end of file
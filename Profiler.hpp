@@ -0,0 +1,285 @@
+#pragma once
+
+#include "Debugging.hpp"
+#include "Expression.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <ratio>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace SymbolicMath {
+namespace ImplDetails {
+template <class T>
+inline constexpr char profiler_tag = 0;
+
+template <unsigned I>
+struct ProfilerCalibrationTag {};
+
+template <class Duration>
+struct ProfilerFrame {
+  const void* tag;
+  std::string_view type_name;
+  std::size_t parent;
+  std::uint64_t calls = 0;
+  Duration total = Duration::zero();
+  std::vector<std::size_t> children;
+};
+
+template <class Duration>
+struct ProfilerTotals {
+  std::uint64_t calls = 0;
+  Duration total = Duration::zero();
+  Duration self = Duration::zero();
+};
+}  // namespace ImplDetails
+
+// Clock over the CPU cycle counter (rdtsc on x86, cntvct_el0 on AArch64); durations count cycles, not seconds.
+// Other targets fall back to steady_clock ticks.
+struct CycleClock {
+  using rep = std::int64_t;
+  using period = std::ratio<1>;
+  using duration = std::chrono::duration<rep, period>;
+  using time_point = std::chrono::time_point<CycleClock>;
+  static constexpr bool is_steady = true;
+
+  static time_point now() noexcept {
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+    return time_point(duration(static_cast<rep>(__rdtsc())));
+#elif defined(__aarch64__)
+    std::uint64_t ticks;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+    return time_point(duration(static_cast<rep>(ticks)));
+#else
+    return time_point(duration(static_cast<rep>(std::chrono::steady_clock::now().time_since_epoch().count())));
+#endif
+  }
+};
+
+// Records a call tree of every unary and binary node visited by Expression::Profile; leaves (variables and
+// constants) are not recorded. Plain operator() never touches a profiler, so evaluation costs nothing extra unless
+// Profile is called. A profiler is not thread safe, use one per thread.
+//
+// Reading the clock costs about as much as a cheap node, so the constructor measures the cost of one Enter/Leave
+// pair and every reported time has that overhead removed, both the frame's own and that of the frames nested in it.
+template <class Clock = std::chrono::steady_clock>
+class BasicProfiler {
+ public:  // Aliases
+  using duration = typename Clock::duration;
+
+  using Frame = ImplDetails::ProfilerFrame<duration>;
+  using Totals = ImplDetails::ProfilerTotals<duration>;
+
+ public:  // Members
+  // Reports count cycles for CycleClock and nanoseconds otherwise.
+  static constexpr std::string_view unit = std::is_same_v<Clock, CycleClock> ? "cycles" : "ns";
+
+ private:  // Aliases
+  using token_t = std::pair<std::size_t, typename Clock::time_point>;
+
+ private:  // Members
+  std::vector<Frame> frames;
+  std::size_t current = 0;
+  // Time a frame records around an empty body, and time one Enter/Leave pair adds to the enclosing frame.
+  duration inner_overhead = duration::zero();
+  duration outer_overhead = duration::zero();
+
+ public:  // Constructors
+  BasicProfiler() : frames{Frame{nullptr, "root", 0}} { Calibrate(); }
+
+ public:  // Methods
+  template <class E>
+  token_t Enter() {
+    const void* tag = &ImplDetails::profiler_tag<E>;
+    std::size_t child = 0;
+    for (auto index : frames[current].children)
+      if (frames[index].tag == tag)
+        child = index;
+    if (child == 0) {
+      child = frames.size();
+      frames.push_back(Frame{tag, GetTypeName<E>(), current});
+      frames[current].children.push_back(child);
+    }
+    current = child;
+    return {child, Clock::now()};
+  }
+
+  void Leave(const token_t& token) {
+    auto& frame = frames[token.first];
+    frame.total += Clock::now() - token.second;
+    ++frame.calls;
+    current = frame.parent;
+  }
+
+  // Clears the recorded frames and measures the Enter/Leave overhead again.
+  void Reset() {
+    frames.assign(1, Frame{nullptr, "root", 0});
+    current = 0;
+    Calibrate();
+  }
+
+  const std::vector<Frame>& GetFrames() const noexcept { return frames; }
+
+  std::pair<duration, duration> GetOverhead() const noexcept { return {inner_overhead, outer_overhead}; }
+
+  // Inclusive time of every frame, without the profiling overhead of the frame and of its descendants.
+  std::vector<duration> InclusiveTimes() const {
+    std::vector<std::uint64_t> nested_calls(frames.size(), 0);
+    for (std::size_t index = frames.size(); index-- > 1;)
+      nested_calls[frames[index].parent] += frames[index].calls + nested_calls[index];
+
+    std::vector<duration> times(frames.size(), duration::zero());
+    for (std::size_t index = 1; index < frames.size(); ++index) {
+      const auto& frame = frames[index];
+      const auto overhead = static_cast<typename duration::rep>(frame.calls) * inner_overhead +
+                            static_cast<typename duration::rep>(nested_calls[index]) * outer_overhead;
+      times[index] = std::max(duration::zero(), frame.total - overhead);
+    }
+
+    // The overhead estimate is an average, so the children of a frame may be left with more time than the frame
+    // itself; scale them down to fit, parents first, so that self times never go negative.
+    for (std::size_t index = 1; index < frames.size(); ++index) {
+      auto children = duration::zero();
+      for (auto child : frames[index].children)
+        children += times[child];
+      if (children <= times[index])
+        continue;
+      auto remaining = times[index];
+      for (auto child : frames[index].children) {
+        const auto share = static_cast<long double>(times[child].count()) * times[index].count() / children.count();
+        times[child] = std::min(remaining, duration(static_cast<typename duration::rep>(share)));
+        remaining -= times[child];
+      }
+    }
+    return times;
+  }
+
+  // Time spent in every frame excluding its children; the self times of a subtree add up to its inclusive time.
+  std::vector<duration> SelfTimes() const {
+    auto times = InclusiveTimes();
+    auto self = times;
+    for (std::size_t index = 1; index < frames.size(); ++index)
+      self[frames[index].parent] -= times[index];
+    self[0] = duration::zero();
+    return self;
+  }
+
+  // Totals per node type, e.g. "_Sin", summed over every subtree and call path.
+  std::map<std::string_view, Totals> ByNodeType() const {
+    return Aggregate([](const Frame& frame) { return GetNodeName(frame.type_name); });
+  }
+
+  // Totals per unique subtree, labelled by its full type name.
+  std::map<std::string_view, Totals> BySubtree() const {
+    return Aggregate([](const Frame& frame) { return frame.type_name; });
+  }
+
+  // Collapsed stacks ("_Plus;_Sin;_Multiply 1234") with self time in `unit`, the input format of flamegraph.pl,
+  // speedscope and inferno.
+  void DumpFolded(std::ostream& out) const {
+    const auto self = SelfTimes();
+    for (std::size_t index = 1; index < frames.size(); ++index) {
+      std::vector<std::string_view> path;
+      for (auto frame = index; frame != 0; frame = frames[frame].parent)
+        path.push_back(GetNodeName(frames[frame].type_name));
+      std::string stack;
+      for (auto name = path.rbegin(); name != path.rend(); ++name)
+        stack.append(name == path.rbegin() ? "" : ";").append(*name);
+      out << stack << ' ' << Count(self[index]) << '\n';
+    }
+  }
+
+  // Tab separated calls, inclusive and self time in `unit` per node type followed by per subtree.
+  void DumpTotals(std::ostream& out) const {
+    const auto dump = [&out](std::string_view title, const std::map<std::string_view, Totals>& totals) {
+      out << title << "\tcalls\ttotal_" << unit << "\tself_" << unit << '\n';
+      for (const auto& [label, entry] : totals)
+        out << label << '\t' << entry.calls << '\t' << Count(entry.total) << '\t' << Count(entry.self) << '\n';
+    };
+    dump("node_type", ByNodeType());
+    dump("subtree", BySubtree());
+  }
+
+ private:  // Methods
+  static auto Count(duration time) {
+    if constexpr (std::is_same_v<Clock, CycleClock>)
+      return time.count();
+    else
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(time).count();
+  }
+
+  // Replays a parent frame with two alternating leaf children, the shape of a binary node, and keeps the fastest
+  // of several rounds so that interrupts during calibration do not inflate the correction.
+  void Calibrate() {
+    using parent_t = ImplDetails::ProfilerCalibrationTag<0>;
+    using left_t = ImplDetails::ProfilerCalibrationTag<1>;
+    using right_t = ImplDetails::ProfilerCalibrationTag<2>;
+    constexpr unsigned rounds = 8, pairs = 128;
+
+    inner_overhead = outer_overhead = duration::max();
+    for (unsigned round = 0; round < rounds; ++round) {
+      frames.assign(1, Frame{nullptr, "root", 0});
+      current = 0;
+      const auto parent = Enter<parent_t>();
+      for (unsigned pair = 0; pair < pairs; ++pair) {
+        Leave(Enter<left_t>());
+        Leave(Enter<right_t>());
+      }
+      Leave(parent);
+
+      const auto inner = (frames[2].total + frames[3].total) / (2 * pairs);
+      inner_overhead = std::min(inner_overhead, inner);
+      outer_overhead = std::min(outer_overhead, (frames[1].total - inner) / (2 * pairs));
+    }
+    frames.assign(1, Frame{nullptr, "root", 0});
+    current = 0;
+  }
+
+  template <class F>
+  std::map<std::string_view, Totals> Aggregate(const F& label) const {
+    const auto inclusive = InclusiveTimes();
+    const auto self = SelfTimes();
+    std::map<std::string_view, Totals> totals;
+    for (std::size_t index = 1; index < frames.size(); ++index) {
+      auto& entry = totals[label(frames[index])];
+      entry.calls += frames[index].calls;
+      entry.self += self[index];
+      if (!HasAncestorWithLabel(index, label))
+        entry.total += inclusive[index];
+    }
+    return totals;
+  }
+
+  // Nested frames with the same label are already counted in the outermost frame's inclusive time.
+  template <class F>
+  bool HasAncestorWithLabel(std::size_t index, const F& label) const {
+    const auto own = label(frames[index]);
+    for (auto frame = frames[index].parent; frame != 0; frame = frames[frame].parent)
+      if (label(frames[frame]) == own)
+        return true;
+    return false;
+  }
+};
+
+using Profiler = BasicProfiler<>;
+using CycleProfiler = BasicProfiler<CycleClock>;
+
+// Evaluates expr like expr(x...) while recording every node visited into profiler.
+template <class E, class Clock, class... X>
+auto Profile(BasicProfiler<Clock>& profiler, const Expression<E>& expr, const X&... x) {
+  return expr.CastToUnderlying().Profile(profiler, x...);
+}
+}  // namespace SymbolicMath
\ No newline at end of file
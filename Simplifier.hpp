@@ -104,6 +104,11 @@ template <class T1, T1 v1, class T2, T2 v2, template <class, class> class Binary
 constexpr bool is_integrally_evaluated_v<Binary<IntegralConstant<T1, v1>, IntegralConstant<T2, v2>>> =
     std::is_integral_v<decltype(ImplDetails::EvaluateB<T1, v1, T2, v2, Binary>)>;
 
+// Integer division truncates, so a quotient of integral constants only folds to an IntegralConstant when it is exact.
+template <class T1, T1 v1, class T2, T2 v2>
+constexpr bool is_integrally_evaluated_v<ImplDetails::_Divide<IntegralConstant<T1, v1>, IntegralConstant<T2, v2>>> =
+    v2 != 0 && v1 % v2 == 0;
+
 template <class E>
 constexpr auto Simplify(const Expression<E>& expr) noexcept {
   return expr.CastToUnderlying();
@@ -129,7 +134,7 @@ template <class T, T v,
           template <class> class Unary,
           class = std::enable_if_t<is_integrally_evaluated_v<Unary<IntegralConstant<T, v>>>>>
 constexpr auto Simplify(const Expression<Unary<IntegralConstant<T, v>>>& expr) {
-  constexpr auto output = expr.CastToUnderlying().Evaluate();
+  constexpr auto output = ImplDetails::EvaluateU<T, v, Unary>;
   return IntegralConstant<decltype(output), output>{};
 }
 // clang-format on
@@ -150,7 +155,7 @@ template <class T1, T1 v1, class T2, T2 v2,
           template <class, class> class Binary,
           class = std::enable_if_t<is_integrally_evaluated_v<Binary<IntegralConstant<T1, v1>, IntegralConstant<T2, v2>>>>>
 constexpr auto Simplify(const Expression<Binary<IntegralConstant<T1, v1>, IntegralConstant<T2, v2>>>& expr) {
-  constexpr auto output = expr.CastToUnderlying().Evaluate();
+  constexpr auto output = ImplDetails::EvaluateB<T1, v1, T2, v2, Binary>;
   return IntegralConstant<decltype(output), output>{};
 }
 // clang-format on
@@ -165,19 +170,25 @@ constexpr auto Simplify(const Expression<Binary<E1, E2>>& expr) {
 }
 // clang-format on
 
-template <class E, class T>
+template <class E, class T, class = std::enable_if_t<!is_integral_constant_v<E>>>
 constexpr auto Simplify(const ImplDetails::_Plus<E, IntegralConstant<T, 0>>& expr) noexcept {
   auto [e, _] = expr.GetSubs();
   return e;
 }
 
-template <class T, class E>
+template <class T, class E, class = std::enable_if_t<!is_integral_constant_v<E>>>
+constexpr auto Simplify(const ImplDetails::_Plus<IntegralConstant<T, 0>, E>& expr) noexcept {
+  auto [_, e] = expr.GetSubs();
+  return e;
+}
+
+template <class T, class E, class = std::enable_if_t<!is_integral_constant_v<E>>>
 constexpr auto Simplify(const ImplDetails::_Minus<IntegralConstant<T, 0>, E>& expr) noexcept {
   auto [_, e] = expr.GetSubs();
   return -e;
 }
 
-template <class E, class T>
+template <class E, class T, class = std::enable_if_t<!is_integral_constant_v<E>>>
 constexpr auto Simplify(const ImplDetails::_Minus<E, IntegralConstant<T, 0>>& expr) noexcept {
   auto [e, _] = expr.GetSubs();
   return e;
@@ -213,35 +224,43 @@ constexpr auto Simplify(const ImplDetails::_Minus<E1, ImplDetails::_Plus<E2, E3>
     return -e.first;
 }
 
-template <class T, class E>
+template <class T, class E, class = std::enable_if_t<!is_integral_constant_v<E>>>
 constexpr auto Simplify(const ImplDetails::_Multiply<IntegralConstant<T, 1>, E>& expr) noexcept {
   auto [_, e] = expr.GetSubs();
   return e;
 }
 
-template <class E, class T>
+template <class E, class T, class = std::enable_if_t<!is_integral_constant_v<E>>>
 constexpr auto Simplify(const ImplDetails::_Multiply<E, IntegralConstant<T, 1>>& expr) noexcept {
   auto [e, _] = expr.GetSubs();
   return e;
 }
 
-template <class T, class E>
+template <class T, class E, class = std::enable_if_t<!is_integral_constant_v<E>>>
 constexpr auto Simplify(const ImplDetails::_Multiply<IntegralConstant<T, 0>, E>& expr) noexcept {
   return IntegralConstant<int, 0>{};
 }
 
-template <class E, class T>
+template <class E, class T, class = std::enable_if_t<!is_integral_constant_v<E>>>
 constexpr auto Simplify(const ImplDetails::_Multiply<E, IntegralConstant<T, 0>>& expr) noexcept {
   return IntegralConstant<int, 0>{};
 }
 
-template <class E, class T>
+// Any other quotient of integral constants is folded in floating point.
+template <class T1, T1 v1, class T2, T2 v2,
+          class = std::enable_if_t<!is_integrally_evaluated_v<
+              ImplDetails::_Divide<IntegralConstant<T1, v1>, IntegralConstant<T2, v2>>>>>
+constexpr auto Simplify(const ImplDetails::_Divide<IntegralConstant<T1, v1>, IntegralConstant<T2, v2>>& expr) {
+  return Constant<double>(static_cast<double>(v1) / static_cast<double>(v2));
+}
+
+template <class E, class T, class = std::enable_if_t<!is_integral_constant_v<E>>>
 constexpr auto Simplify(const ImplDetails::_Divide<E, IntegralConstant<T, 1>>& expr) noexcept {
   auto [e, _] = expr.GetSubs();
   return e;
 }
 
-template <class T, class E>
+template <class T, class E, class = std::enable_if_t<!is_integral_constant_v<E>>>
 constexpr auto Simplify(const ImplDetails::_Divide<IntegralConstant<T, 0>, E>& expr) noexcept {
   return IntegralConstant<int, 0>{};
 }
@@ -0,0 +1,194 @@
+#pragma once
+
+#include "Expression.hpp"
+
+#include "OdeSystem.hpp"
+#include "Variable.hpp"
+
+#include "Lanes.hpp"
+#include "LinearAlgebra.hpp"
+#include "Parallel.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace SymbolicMath {
+namespace ImplDetails {
+template <class E, unsigned... I>
+auto MakeGradientSystem(const E& expr, std::integer_sequence<unsigned, I...>) {
+  return OdeSystem(expr.template Derive<I>()...);
+}
+
+template <class T, std::size_t W, std::size_t N>
+LaneBlock<T, W> MaxNorm(const std::array<LaneBlock<T, W>, N>& v) noexcept {
+  LaneBlock<T, W> norm(0);
+  for (const auto& x : v)
+    norm = max(norm, abs(x));
+  return norm;
+}
+
+template <class T, std::size_t W, std::size_t N>
+LaneBlock<T, W> SquaredNorm(const std::array<LaneBlock<T, W>, N>& v) noexcept {
+  LaneBlock<T, W> norm(0);
+  for (const auto& x : v)
+    norm = norm + x * x;
+  return norm;
+}
+
+// Iterates every point in place, W lanes at a time. Each chunk of points keeps a block of W slots in structure of
+// arrays layout and calls iterate(x, active, stepping) on it once per iteration, where active marks the occupied
+// slots and stepping those that still have iterations left. iterate returns the masks of the active lanes that
+// converged at x and of those that failed, and advances x in the other stepping lanes only. A slot whose lane has
+// converged, failed or run out of iterations is written back and refilled with the next pending point, so finished
+// lanes stop costing work. Returns the number of points that did not converge.
+template <std::size_t W, class T, std::size_t N, class F>
+std::size_t IterateBatch(std::vector<std::array<T, N>>& points, unsigned threads, unsigned max_iterations,
+                         const F& iterate) {
+  std::vector<unsigned char> unconverged(points.size(), 0);
+  ParallelFor(points.size(), threads, [&](std::size_t begin, std::size_t end) {
+    std::array<LaneBlock<T, W>, N> x{};
+    std::array<std::size_t, W> lanes{};
+    std::array<unsigned, W> iterations{};
+    LaneMask<T, W> active{}, stepping{};
+    for (std::size_t next = begin;;) {
+      for (std::size_t slot = 0; slot < W && next < end; ++slot) {
+        if (active[slot])
+          continue;
+        for (std::size_t i = 0; i < N; ++i)
+          x[i][slot] = points[next][i];
+        lanes[slot] = next++;
+        iterations[slot] = 0;
+        active.Set(slot, true);
+      }
+      if (!Any(active))
+        break;
+
+      for (std::size_t slot = 0; slot < W; ++slot)
+        stepping.Set(slot, active[slot] && iterations[slot] < max_iterations);
+      const auto [converged, failed] = iterate(x, active, stepping);
+      for (std::size_t slot = 0; slot < W; ++slot) {
+        if (!active[slot])
+          continue;
+        if (converged[slot] || failed[slot] || !stepping[slot]) {
+          for (std::size_t i = 0; i < N; ++i)
+            points[lanes[slot]][i] = x[i][slot];
+          unconverged[lanes[slot]] = !converged[slot];
+          active.Set(slot, false);
+        } else {
+          ++iterations[slot];
+        }
+      }
+    }
+  });
+  return static_cast<std::size_t>(std::count(unconverged.begin(), unconverged.end(), 1));
+}
+}  // namespace ImplDetails
+
+// Lanes per block in SolveBatch and MinimizeBatch unless given explicitly, e.g. SolveBatch<8>(...).
+constexpr std::size_t solver_lane_width = 4;
+
+// Solves f(x) = 0 for every starting point in place with damped Newton iterations, where f_i is the i-th equation
+// over Variable<0>..Variable<N-1>. The Jacobian is derived once for the whole batch and evaluated at W points per
+// pass on LaneBlock values. A lane converges once max|f(x)| <= tolerance; lanes with a singular Jacobian or where no
+// halved step reduces the residual stop early at their last iterate and count as failures.
+// Returns the number of lanes that did not converge.
+template <std::size_t W = solver_lane_width, class... E, class T, std::size_t N>
+std::size_t SolveBatch(const std::tuple<E...>& equations, std::vector<std::array<T, N>>& points,
+                       unsigned threads = 1, unsigned max_iterations = 50,
+                       T tolerance = std::sqrt(std::numeric_limits<T>::epsilon())) {
+  static_assert(sizeof...(E) == N, "SolveBatch needs as many equations as variables");
+  using block_t = ImplDetails::LaneBlock<T, W>;
+  using mask_t = ImplDetails::LaneMask<T, W>;
+  const auto system = std::apply([](const auto&... e) { return OdeSystem(e...); }, equations);
+
+  const auto iterate = [&](std::array<block_t, N>& x, const mask_t& active, const mask_t& stepping) {
+    std::array<block_t, N> f, step, trial;
+    std::array<std::array<block_t, N>, N> jac;
+    system.Evaluate(x, f, jac);
+    const auto converged = active & (ImplDetails::MaxNorm(f) <= block_t(tolerance));
+
+    step = f;
+    const auto solved = ImplDetails::SolveDense(jac, step);
+    auto searching = stepping & !converged & solved;
+    const auto singular = stepping & !converged & !solved;
+
+    // Halve the step until the residual decreases; a lane where it never does keeps its last iterate and fails.
+    const block_t residual = ImplDetails::SquaredNorm(f);
+    block_t t(1);
+    for (unsigned halving = 0; halving < 30 && ImplDetails::Any(searching); ++halving, t = t / 2) {
+      for (std::size_t i = 0; i < N; ++i)
+        trial[i] = x[i] - t * step[i];
+      system.Rhs(trial, f);
+      const auto decreased = searching & (ImplDetails::SquaredNorm(f) < residual);
+      for (std::size_t i = 0; i < N; ++i)
+        x[i] = ImplDetails::Select(decreased, trial[i], x[i]);
+      searching = searching & !decreased;
+    }
+    return std::make_pair(converged, singular | searching);
+  };
+  return ImplDetails::IterateBatch<W>(points, threads, max_iterations, iterate);
+}
+
+template <std::size_t W = solver_lane_width, class E, class T>
+std::size_t SolveBatch(const Expression<E>& equation, std::vector<std::array<T, 1>>& points, unsigned threads = 1,
+                       unsigned max_iterations = 50, T tolerance = std::sqrt(std::numeric_limits<T>::epsilon())) {
+  return SolveBatch<W>(std::make_tuple(equation.CastToUnderlying()), points, threads, max_iterations, tolerance);
+}
+
+// Minimizes expr over Variable<0>..Variable<N-1> from every starting point in place. The gradient and Hessian are
+// derived once with Derive and evaluated by one fused kernel at W points per pass. Each iteration takes the Newton
+// step, or steepest descent in the lanes where the Hessian is singular or the Newton step does not descend, with an
+// Armijo backtracking line search. A lane converges once max|grad| <= tolerance; a lane where the line search finds
+// no sufficient decrease stops at its last iterate and fails. Returns the number of lanes that did not converge.
+template <std::size_t W = solver_lane_width, class E, class T, std::size_t N>
+std::size_t MinimizeBatch(const Expression<E>& expr, std::vector<std::array<T, N>>& points, unsigned threads = 1,
+                          unsigned max_iterations = 100, T tolerance = std::sqrt(std::numeric_limits<T>::epsilon())) {
+  using block_t = ImplDetails::LaneBlock<T, W>;
+  using mask_t = ImplDetails::LaneMask<T, W>;
+  const auto& objective = expr.CastToUnderlying();
+  const auto gradient = ImplDetails::MakeGradientSystem(objective, std::make_integer_sequence<unsigned, N>{});
+  const auto value = [&objective](const std::array<block_t, N>& x) {
+    return ImplDetails::EvaluateAt(objective, x, std::make_index_sequence<N>{});
+  };
+
+  const auto iterate = [&](std::array<block_t, N>& x, const mask_t& active, const mask_t& stepping) {
+    std::array<block_t, N> g, step, trial;
+    std::array<std::array<block_t, N>, N> hessian;
+    gradient.Evaluate(x, g, hessian);
+    const auto converged = active & (ImplDetails::MaxNorm(g) <= block_t(tolerance));
+
+    for (std::size_t i = 0; i < N; ++i)
+      step[i] = -g[i];
+    const auto solved = ImplDetails::SolveDense(hessian, step);
+    block_t slope(0), steepest(0);
+    for (std::size_t i = 0; i < N; ++i) {
+      slope = slope + g[i] * step[i];
+      steepest = steepest - g[i] * g[i];
+    }
+    const auto newton = solved & (slope < block_t(0));
+    for (std::size_t i = 0; i < N; ++i)
+      step[i] = ImplDetails::Select(newton, step[i], -g[i]);
+    slope = ImplDetails::Select(newton, slope, steepest);
+
+    auto searching = stepping & !converged;
+    const block_t f0 = value(x);
+    block_t t(1);
+    for (unsigned halving = 0; halving < 30 && ImplDetails::Any(searching); ++halving, t = t / 2) {
+      for (std::size_t i = 0; i < N; ++i)
+        trial[i] = x[i] + t * step[i];
+      const auto sufficient = searching & (value(trial) <= f0 + T(1e-4) * t * slope);
+      for (std::size_t i = 0; i < N; ++i)
+        x[i] = ImplDetails::Select(sufficient, trial[i], x[i]);
+      searching = searching & !sufficient;
+    }
+    return std::make_pair(converged, searching);
+  };
+  return ImplDetails::IterateBatch<W>(points, threads, max_iterations, iterate);
+}
+}  // namespace SymbolicMath
\ No newline at end of file
@@ -10,4 +10,12 @@
 
 #include "Operators.hpp"
 
-#include "Functions.hpp"
\ No newline at end of file
+#include "Functions.hpp"
+
+#include "OdeSystem.hpp"
+
+#include "Profiler.hpp"
+
+#include "InternTable.hpp"
+
+#include "Solvers.hpp"
\ No newline at end of file
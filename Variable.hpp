@@ -20,6 +20,11 @@ class Variable : public Expression<Variable<N>> {
     return std::get<N>(std::forward_as_tuple(x...));
   }
 
+  template <class Profiler, class... X>
+  constexpr auto Profile(Profiler&, const X&... x) const noexcept {
+    return (*this)(x...);
+  }
+
   template <unsigned M>
   constexpr auto Derive() const noexcept {
     if constexpr (M == N)
@@ -0,0 +1,64 @@
+#include "Harness.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace fs = std::filesystem;
+using namespace Benchmarks;
+
+namespace {
+// Translation unit evaluating e_depth and de_depth/dx, where e_0 = x and e_k+1 = Sin(e_k) * y + x.
+std::string MakeSource(unsigned depth) {
+  return "#include \"SymbolicMath.hpp\"\n"
+         "using namespace SymbolicMath;\n"
+         "template <unsigned K, class E, class X, class Y>\n"
+         "auto Nest(const E& e, const X& x, const Y& y) {\n"
+         "  if constexpr (K == 0)\n"
+         "    return e;\n"
+         "  else\n"
+         "    return Nest<K - 1>(Sin(e) * y + x, x, y);\n"
+         "}\n"
+         "double Evaluate(double a, double b) {\n"
+         "  auto [x, y] = MakeVariables<2>();\n"
+         "  auto e = Nest<" +
+         std::to_string(depth) +
+         ">(x, x, y);\n"
+         "  return e(a, b) + D(e, x)(a, b);\n"
+         "}\n";
+}
+
+std::string MakeCommand(const fs::path& source, const fs::path& object) {
+#if defined(_MSC_VER)
+  return "\"\"" SYMBMATH_CXX_COMPILER "\" /nologo /std:c++17 /O2 /c /I\"" SYMBMATH_SOURCE_DIR "\" \"" +
+         source.string() + "\" /Fo\"" + object.string() + "\" > NUL\"";
+#else
+  return "\"" SYMBMATH_CXX_COMPILER "\" -std=c++17 -O2 -c -I\"" SYMBMATH_SOURCE_DIR "\" \"" + source.string() +
+         "\" -o \"" + object.string() + "\"";
+#endif
+}
+}  // namespace
+
+int main() {
+  const fs::path work_dir = SYMBMATH_WORK_DIR;
+  fs::create_directories(work_dir);
+
+  for (unsigned depth : {1u, 2u, 4u, 8u, 16u, 32u, 64u}) {
+    const auto source = work_dir / ("depth_" + std::to_string(depth) + ".cpp");
+    const auto object = work_dir / ("depth_" + std::to_string(depth) + ".o");
+    std::ofstream(source) << MakeSource(depth);
+
+    const auto start = std::chrono::steady_clock::now();
+    const int status = std::system(MakeCommand(source, object).c_str());
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    Record record("compile", "nested_sin_with_derivative");
+    record.Field("depth", depth).Field("status", status);
+    if (status == 0)
+      record.Field("seconds", std::chrono::duration<double>(elapsed).count())
+          .Field("object_bytes", fs::file_size(object));
+  }
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "../Expression.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace Benchmarks {
+template <class T>
+inline void DoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const void* sink;
+  sink = &value;
+#endif
+}
+
+// Uniformly distributed inputs with a fixed seed so runs are comparable.
+inline std::vector<double> MakeInputs(std::size_t count, double lo = -2, double hi = 2) {
+  std::mt19937_64 engine(42);
+  std::uniform_real_distribution<double> distribution(lo, hi);
+  std::vector<double> inputs(count);
+  for (auto& input : inputs)
+    input = distribution(engine);
+  return inputs;
+}
+
+// Calls func(i) for i in [0, size) repeatedly until min_time has passed and returns nanoseconds per call.
+template <class F>
+double TimePerCall(std::size_t size, const F& func, std::chrono::milliseconds min_time = std::chrono::milliseconds(200)) {
+  using clock = std::chrono::steady_clock;
+  std::size_t calls = 0;
+  const auto start = clock::now();
+  auto elapsed = clock::duration::zero();
+  do {
+    for (std::size_t i = 0; i < size; ++i)
+      DoNotOptimize(func(i));
+    calls += size;
+    elapsed = clock::now() - start;
+  } while (elapsed < min_time);
+  return std::chrono::duration<double, std::nano>(elapsed).count() / calls;
+}
+
+// Number of nodes in the expression tree of E.
+template <class E>
+constexpr std::size_t node_count_v = 1;
+
+template <class E, template <class> class Unary>
+constexpr std::size_t node_count_v<Unary<E>> =
+    std::is_base_of_v<SymbolicMath::UnaryExpression<E, Unary>, Unary<E>> ? 1 + node_count_v<E> : 1;
+
+template <class E1, class E2, template <class, class> class Binary>
+constexpr std::size_t node_count_v<Binary<E1, E2>> =
+    std::is_base_of_v<SymbolicMath::BinaryExpression<E1, E2, Binary>, Binary<E1, E2>> ? 1 + node_count_v<E1> + node_count_v<E2> : 1;
+
+// Results are written one JSON object per line to std::cout.
+class Record {
+ private:  // Members
+  std::ostream& out;
+  bool first = true;
+
+ public:  // Constructors
+  Record(std::string_view suite, std::string_view name) : out(std::cout) {
+    out << '{';
+    Field("suite", suite);
+    Field("name", name);
+  }
+  ~Record() { out << '}' << std::endl; }
+
+ public:  // Methods
+  Record& Field(std::string_view key, std::string_view value) {
+    Key(key) << '"' << value << '"';
+    return *this;
+  }
+
+  template <class T>
+  Record& Field(std::string_view key, const T& value) {
+    Key(key) << value;
+    return *this;
+  }
+
+ private:  // Methods
+  std::ostream& Key(std::string_view key) {
+    if (!first)
+      out << ',';
+    first = false;
+    return out << '"' << key << "\":";
+  }
+};
+}  // namespace Benchmarks
\ No newline at end of file
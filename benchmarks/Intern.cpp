@@ -0,0 +1,47 @@
+#include "../SymbolicMath.hpp"
+#include "Harness.hpp"
+
+#include <chrono>
+#include <thread>
+
+using namespace SymbolicMath;
+using namespace Benchmarks;
+
+namespace {
+constexpr std::size_t operations_per_thread = 20000;
+constexpr std::size_t unique_constants = 1024;
+
+// Every thread interns the same family of models, half of them with commuted operands, so most calls hit
+// entries another thread has already inserted.
+void InternFamily(InternTable& table, std::size_t seed) {
+  auto [x, y] = MakeVariables<2>();
+  for (std::size_t i = 0; i < operations_per_thread; ++i) {
+    const double c = static_cast<double>((i * 7 + seed) % unique_constants);
+    if (i % 2)
+      DoNotOptimize(table.Intern(Constant(c) * Sin(x + y) + Exp(Constant(c) * y)).id);
+    else
+      DoNotOptimize(table.Intern(Exp(y * Constant(c)) + Sin(y + x) * Constant(c)).id);
+  }
+}
+}  // namespace
+
+int main() {
+  for (unsigned threads : {1u, 2u, 4u, 8u, 16u, 32u, 64u}) {
+    InternTable table;
+    std::vector<std::thread> workers;
+    const auto start = std::chrono::steady_clock::now();
+    for (unsigned t = 0; t < threads; ++t)
+      workers.emplace_back([&table, t] { InternFamily(table, t); });
+    for (auto& worker : workers)
+      worker.join();
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    Record("intern", "contention")
+        .Field("threads", threads)
+        .Field("operations", threads * operations_per_thread)
+        .Field("unique", table.Size())
+        .Field("ns_per_operation", seconds * 1e9 / (threads * operations_per_thread))
+        .Field("operations_per_second", threads * operations_per_thread / seconds);
+  }
+  return 0;
+}
\ No newline at end of file
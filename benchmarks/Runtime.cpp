@@ -0,0 +1,137 @@
+#include "../SymbolicMath.hpp"
+#include "Harness.hpp"
+
+#include <cmath>
+#include <string>
+#include <utility>
+
+using namespace SymbolicMath;
+using namespace Benchmarks;
+
+namespace {
+constexpr std::size_t input_count = 4096;
+
+template <class F>
+double TimeBinary(const std::vector<double>& a, const std::vector<double>& b, const F& func) {
+  return TimePerCall(a.size(), [&](std::size_t i) { return func(a[i], b[i]); });
+}
+
+// Scalar operator() against the equivalent hand-written C++ for the expressions of main.cpp.
+void ScalarVersusHandWritten(const std::vector<double>& a, const std::vector<double>& b) {
+  auto [x, y] = MakeVariables<2>();
+  auto expr1 = Cos(x + y) / Cos(y + x) + Sin(x + y * x) - Sin(x * y + x);
+  auto expr2 = Exp(x + y) - (Sin(x) + Exp(y + x));
+  auto expr3 = D(Exp(x) + Sin(Cos(x + y)), y);
+  auto expr4 = D(x, x) + IntegralConstant<short, 1>{};
+  auto expr5 = Sin(expr4) + IntegralConstant<int, 1>{};
+
+  // handwritten is the formula as written in main.cpp, simplified_handwritten the formula Simplify reduces it to.
+  const auto report = [&](std::string_view name, const auto& expr, const auto& hand, const auto& simplified) {
+    Record("scalar", name)
+        .Field("nodes", node_count_v<std::decay_t<decltype(expr)>>)
+        .Field("expression_ns", TimeBinary(a, b, expr))
+        .Field("handwritten_ns", TimeBinary(a, b, hand))
+        .Field("simplified_handwritten_ns", TimeBinary(a, b, simplified));
+  };
+
+  report(
+      "expr1", expr1,
+      [](double x, double y) {
+        return std::cos(x + y) / std::cos(y + x) + std::sin(x + y * x) - std::sin(x * y + x);
+      },
+      [](double, double) { return 1.0; });
+  report(
+      "expr2", expr2, [](double x, double y) { return std::exp(x + y) - (std::sin(x) + std::exp(y + x)); },
+      [](double x, double) { return -std::sin(x); });
+  report(
+      "expr3", expr3, [](double x, double y) { return -std::cos(std::cos(x + y)) * std::sin(x + y); },
+      [](double x, double y) { return -std::cos(std::cos(x + y)) * std::sin(x + y); });
+  report(
+      "expr4", expr4, [](double, double) { return 2; }, [](double, double) { return 2; });
+  report(
+      "expr5", expr5, [](double, double) { return std::sin(2.) + 1; }, [](double, double) { return std::sin(2.) + 1; });
+}
+
+template <unsigned Order, class E, class V>
+auto NthDerivative(const E& expr, const V& v) {
+  if constexpr (Order == 0)
+    return expr;
+  else
+    return NthDerivative<Order - 1>(D(expr, v), v);
+}
+
+// Derivatives of increasing order of a fixed two-variable expression.
+template <unsigned... Order>
+void DerivativeOrders(const std::vector<double>& a, const std::vector<double>& b,
+                      std::integer_sequence<unsigned, Order...>) {
+  auto [x, y] = MakeVariables<2>();
+  auto expr = Sin(x * y) + Exp(x) * Cos(y);
+  const auto report = [&](unsigned order, const auto& deriv) {
+    Record("derivative_order", "d^n/dx^n(sin(x*y)+exp(x)*cos(y))")
+        .Field("order", order)
+        .Field("nodes", node_count_v<std::decay_t<decltype(deriv)>>)
+        .Field("ns", TimeBinary(a, b, deriv));
+  };
+  (report(Order, NthDerivative<Order>(expr, x)), ...);
+}
+
+// Full gradient of sin(x0*...*xn-1) + exp(x0+...+xn-1) for a growing number of variables.
+template <unsigned N, unsigned... I>
+void GradientOfSize(const std::vector<double>& inputs, std::integer_sequence<unsigned, I...>) {
+  const auto product = (Variable<I>() * ...);
+  const auto sum = (Variable<I>() + ...);
+  const auto expr = Sin(product) + Exp(sum);
+  const auto gradient = std::make_tuple(D(expr, Variable<I>())...);
+
+  const std::size_t points = inputs.size() / N;
+  const double ns = TimePerCall(points, [&](std::size_t i) {
+    const double* p = inputs.data() + i * N;
+    return (std::get<I>(gradient)(p[I]...) + ...);
+  });
+  Record("derivative_variables", "grad(sin(prod)+exp(sum))")
+      .Field("variables", N)
+      .Field("nodes", (node_count_v<std::decay_t<decltype(std::get<I>(gradient))>> + ...))
+      .Field("ns", ns);
+}
+
+template <unsigned... N>
+void DerivativeVariables(const std::vector<double>& inputs, std::integer_sequence<unsigned, N...>) {
+  (GradientOfSize<N>(inputs, std::make_integer_sequence<unsigned, N>{}), ...);
+}
+
+// The same expressions built with and without Simplify, compared by tree size and evaluation time.
+void SimplifierEffectiveness(const std::vector<double>& a, const std::vector<double>& b) {
+  using namespace SymbolicMath::ImplDetails;
+  auto [x, y] = MakeVariables<2>();
+
+  const auto report = [&](std::string_view name, const auto& raw, const auto& simplified) {
+    Record("simplifier", name)
+        .Field("raw_nodes", node_count_v<std::decay_t<decltype(raw)>>)
+        .Field("simplified_nodes", node_count_v<std::decay_t<decltype(simplified)>>)
+        .Field("raw_ns", TimeBinary(a, b, raw))
+        .Field("simplified_ns", TimeBinary(a, b, simplified));
+  };
+
+  report("expr1",
+         _Minus(_Plus(_Divide(_Cos(_Plus(x, y)), _Cos(_Plus(y, x))), _Sin(_Plus(x, _Multiply(y, x)))),
+                _Sin(_Plus(_Multiply(x, y), x))),
+         Cos(x + y) / Cos(y + x) + Sin(x + y * x) - Sin(x * y + x));
+  report("expr2", _Minus(_Exp(_Plus(x, y)), _Plus(_Sin(x), _Exp(_Plus(y, x)))),
+         Exp(x + y) - (Sin(x) + Exp(y + x)));
+  report("x*1+0-x*1", _Minus(_Plus(_Multiply(x, IntegralConstant<int, 1>()), IntegralConstant<int, 0>()),
+                             _Multiply(x, IntegralConstant<int, 1>())),
+         x * IntegralConstant<int, 1>() + IntegralConstant<int, 0>() - x * IntegralConstant<int, 1>());
+}
+}  // namespace
+
+int main() {
+  const auto a = MakeInputs(input_count);
+  const auto b = MakeInputs(input_count, 0.5, 1.5);
+  const auto inputs = MakeInputs(8 * input_count);
+
+  ScalarVersusHandWritten(a, b);
+  DerivativeOrders(a, b, std::integer_sequence<unsigned, 0, 1, 2, 3, 4>{});
+  DerivativeVariables(inputs, std::integer_sequence<unsigned, 1, 2, 4, 8>{});
+  SimplifierEffectiveness(a, b);
+  return 0;
+}
\ No newline at end of file
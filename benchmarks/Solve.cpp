@@ -0,0 +1,59 @@
+#include "../SymbolicMath.hpp"
+#include "Harness.hpp"
+
+#include <chrono>
+#include <thread>
+
+using namespace SymbolicMath;
+using namespace Benchmarks;
+
+namespace {
+constexpr std::size_t lanes = 1 << 16;
+
+template <class F>
+void Report(std::string_view name, unsigned threads, std::size_t width, const F& run) {
+  const auto start = std::chrono::steady_clock::now();
+  const std::size_t unconverged = run();
+  const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  Record("solve", name)
+      .Field("threads", threads)
+      .Field("lane_width", width)
+      .Field("lanes", lanes)
+      .Field("unconverged", unconverged)
+      .Field("solves_per_second", lanes / seconds);
+}
+
+// Both solvers on the same starting points with blocks of W lanes.
+template <std::size_t W>
+void SolveWithWidth(unsigned threads, const std::vector<double>& a, const std::vector<double>& b) {
+  auto [x, y] = MakeVariables<2>();
+  const auto one = Constant(1.0);
+  const auto rosenbrock = (one - x) * (one - x) + Constant(100.0) * (y - x * x) * (y - x * x);
+  const auto circle = std::make_tuple(x * x + y * y - Constant(4.0), Sin(x) - y);
+
+  std::vector<std::array<double, 2>> points(lanes);
+  for (std::size_t i = 0; i < lanes; ++i)
+    points[i] = {a[i], b[i]};
+  Report("minimize_rosenbrock", threads, W, [&] { return MinimizeBatch<W>(rosenbrock, points, threads); });
+
+  for (std::size_t i = 0; i < lanes; ++i)
+    points[i] = {a[i], b[i]};
+  Report("solve_circle_sine", threads, W, [&] { return SolveBatch<W>(circle, points, threads); });
+}
+
+template <std::size_t... W>
+void SolveWithWidths(unsigned threads, const std::vector<double>& a, const std::vector<double>& b,
+                     std::index_sequence<W...>) {
+  (SolveWithWidth<W>(threads, a, b), ...);
+}
+}  // namespace
+
+int main() {
+  const auto a = MakeInputs(lanes, -2, 2);
+  const auto b = MakeInputs(lanes, -1, 3);
+
+  const unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+  for (unsigned threads = 1; threads <= max_threads; threads *= 2)
+    SolveWithWidths(threads, a, b, std::index_sequence<1, 2, 4, 8, 16>{});
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cmath>
+#include <iostream>
+
+namespace Tests {
+inline int failures = 0;
+
+inline void Check(bool condition, const char* what, const char* file, int line) {
+  if (condition)
+    return;
+  ++failures;
+  std::cerr << file << ':' << line << ": check failed: " << what << std::endl;
+}
+
+inline void CheckNear(double actual, double expected, double tolerance, const char* what, const char* file,
+                      int line) {
+  if (std::abs(actual - expected) <= tolerance)
+    return;
+  ++failures;
+  std::cerr << file << ':' << line << ": " << what << " = " << actual << ", expected " << expected << std::endl;
+}
+}  // namespace Tests
+
+#define CHECK(condition) Tests::Check((condition), #condition, __FILE__, __LINE__)
+#define CHECK_NEAR(actual, expected, tolerance) \
+  Tests::CheckNear((actual), (expected), (tolerance), #actual, __FILE__, __LINE__)
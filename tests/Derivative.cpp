@@ -0,0 +1,34 @@
+#include "../SymbolicMath.hpp"
+#include "Check.hpp"
+
+#include <cmath>
+#include <type_traits>
+
+using namespace SymbolicMath;
+
+int main() {
+  auto [x, y] = MakeVariables<2>();
+
+  // Factories must nest, not copy, an argument of the node type they build.
+  CHECK((std::is_same_v<decltype(-(-Cos(x))), decltype(Cos(x))>));
+  CHECK((std::is_same_v<decltype(Sin(Sin(x))), ImplDetails::_Sin<ImplDetails::_Sin<Variable<0>>>>));
+  CHECK_NEAR(Sin(Sin(x))(1.0), std::sin(std::sin(1.0)), 1e-15);
+
+  CHECK_NEAR(D(-Cos(x), x)(1.0), std::sin(1.0), 1e-15);
+  CHECK_NEAR(D(Exp(x * y), x)(0.5, 2.0), 2 * std::exp(1.0), 1e-12);
+  CHECK_NEAR(D(x / y, y, y)(1.0, 2.0), 0.25, 1e-15);
+  CHECK_NEAR(D(Tan(x), x)(0.3), 1 / (std::cos(0.3) * std::cos(0.3)), 1e-12);
+
+  // Quotients of integral constants fold exactly or in floating point, never by truncating integer division.
+  CHECK(is_integral_constant_v<decltype(IntegralConstant<int, 6>{} / IntegralConstant<int, 3>{})>);
+  CHECK((IntegralConstant<int, 6>{} / IntegralConstant<int, 3>{})() == 2);
+  CHECK(!is_integral_constant_v<decltype(IntegralConstant<int, 1>{} / IntegralConstant<int, 2>{})>);
+  CHECK_NEAR((IntegralConstant<int, 1>{} / IntegralConstant<int, 2>{})(), 0.5, 0.0);
+  CHECK_NEAR(D(x / IntegralConstant<int, 2>{}, x)(1.0), 0.5, 1e-15);
+  OdeSystem halved(x / IntegralConstant<int, 2>{} + y, y);
+  CHECK(decltype(halved)::nonzeros == 3);
+  std::array<std::array<double, 2>, 2> jac;
+  halved.Jacobian(std::array<double, 2>{1.0, 1.0}, jac);
+  CHECK_NEAR(jac[0][0], 0.5, 1e-15);
+  return Tests::failures != 0;
+}
\ No newline at end of file
@@ -0,0 +1,111 @@
+#include "../SymbolicMath.hpp"
+#include "Check.hpp"
+
+#include <thread>
+#include <vector>
+
+using namespace SymbolicMath;
+
+namespace {
+void Commutation() {
+  auto [x, y] = MakeVariables<2>();
+  InternTable table;
+  const auto xy = table.Intern(x + y);
+  CHECK(table.Size() == 1);
+  const auto yx = table.Intern(y + x);
+  CHECK(yx.id == xy.id);
+  CHECK(table.Size() == 1);
+  CHECK(table.Intern(x - y).id != table.Intern(y - x).id);
+}
+
+void NestedCommutation() {
+  auto [u, v, w] = MakeVariables<3>();
+  InternTable table;
+  const auto first = table.Intern((u + v) * w);
+  const auto second = table.Intern(w * (v + u));
+  CHECK(first.id == second.id);
+  CHECK(GetStructuralKey((u + v) * w) == GetStructuralKey(w * (v + u)));
+  CHECK(table.Intern(Sin((u + v) * w)).id == table.Intern(Sin(w * (v + u))).id);
+  CHECK(table.Intern((u * v) + w).id != first.id);
+}
+
+void Constants() {
+  auto [x] = MakeVariables<1>();
+  InternTable table;
+  const auto half = table.Intern(Constant(0.5) * x);
+  CHECK(table.Intern(Constant(0.5) * x).id == half.id);
+  CHECK(table.Intern(Constant(0.25) * x).id != half.id);
+  CHECK(table.Intern(Constant(0.5f) * x).id != half.id);
+  CHECK(table.Intern(Constant(-0.0) * x).id != table.Intern(Constant(0.0) * x).id);
+}
+
+void SharedInstance() {
+  auto [x, y] = MakeVariables<2>();
+  InternTable table;
+  const auto first = table.Intern(Exp(x * y));
+  const auto second = table.Intern(Exp(x * y));
+  CHECK(first.expr == second.expr);
+  CHECK(first.id == second.id);
+  // A commuted form shares the id but keeps an instance of its own type.
+  const auto commuted = table.Intern(Exp(y * x));
+  CHECK(commuted.id == first.id);
+  CHECK((*commuted.expr)(0.5, 2.0) == (*first.expr)(0.5, 2.0));
+}
+
+// Interning an expression assigns ids to its subtrees, so they can be looked up without being interned themselves.
+void Subtrees() {
+  auto [x, y] = MakeVariables<2>();
+  InternTable table;
+  const auto product = table.Intern(Sin(x) * y);
+  // Sin(x) and the product; leaves get no id of their own.
+  CHECK(table.Size() == 2);
+  const auto sine = table.GetId(Sin(x));
+  CHECK(sine != product.id);
+  CHECK(table.Size() == 2);
+  CHECK(table.Intern(Sin(x)).id == sine);
+  CHECK(table.GetId(y * Sin(x)) == product.id);
+  CHECK(table.Size() == 2);
+
+  // Shared subtrees of different roots, in either operand order, get the same id.
+  const auto quotient = table.Intern(Exp(y + x) / (x * y));
+  CHECK(table.GetId(Exp(x + y)) == table.GetId(Exp(y + x)));
+  CHECK(table.GetId(y * x) == table.GetId(x * y));
+  CHECK(table.GetId(x + y) != quotient.id);
+  CHECK(table.Size() == 2 + 4);
+  CHECK(table.GetId(x) != table.GetId(y));
+  CHECK(table.Size() == 2 + 4 + 2);
+}
+
+// Every thread interns the same family of expressions, each in both operand orders, with one constant per thread.
+void Concurrent() {
+  constexpr unsigned thread_count = 8, rounds = 200;
+  auto [x, y] = MakeVariables<2>();
+  InternTable table(4);
+  std::vector<std::thread> threads;
+  for (unsigned thread = 0; thread < thread_count; ++thread)
+    threads.emplace_back([&, thread] {
+      for (unsigned round = 0; round < rounds; ++round) {
+        table.Intern(Sin(x) + y);
+        table.Intern(y + Sin(x));
+        table.Intern(Cos(x * y) - Exp(y));
+        table.Intern(Cos(y * x) - Exp(y));
+        table.Intern(Constant(static_cast<double>(round % 4)) * x);
+        table.Intern(Constant(static_cast<double>(thread)) + y);
+      }
+    });
+  for (auto& thread : threads)
+    thread.join();
+  // Sin(x)+y, Sin(x), Cos(x*y)-Exp(y), Cos(x*y), x*y, Exp(y), four c*x and thread_count c+y.
+  CHECK(table.Size() == 6 + 4 + thread_count);
+}
+}  // namespace
+
+int main() {
+  Commutation();
+  NestedCommutation();
+  Constants();
+  SharedInstance();
+  Subtrees();
+  Concurrent();
+  return Tests::failures != 0;
+}
\ No newline at end of file
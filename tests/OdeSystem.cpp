@@ -0,0 +1,91 @@
+#include "../SymbolicMath.hpp"
+#include "Check.hpp"
+
+#include <cmath>
+
+using namespace SymbolicMath;
+
+namespace {
+void JacobianKnownAnswer() {
+  auto [x, y] = MakeVariables<2>();
+  OdeSystem system(-Cos(x), x * y);
+  using system_t = decltype(system);
+
+  const std::array<double, 2> state{1.0, 2.0};
+  std::array<double, 2> f;
+  std::array<std::array<double, 2>, 2> jac;
+  system.Evaluate(state, f, jac);
+  CHECK_NEAR(f[0], -std::cos(1.0), 1e-15);
+  CHECK_NEAR(f[1], 2.0, 1e-15);
+  CHECK_NEAR(jac[0][0], std::sin(1.0), 1e-15);
+  CHECK_NEAR(jac[0][1], 0.0, 0.0);
+  CHECK_NEAR(jac[1][0], 2.0, 1e-15);
+  CHECK_NEAR(jac[1][1], 1.0, 1e-15);
+
+  std::array<std::array<double, 2>, 2> dense;
+  system.Jacobian(state, dense);
+  CHECK(dense == jac);
+
+  // d(-cos x)/dy is a structural zero.
+  CHECK(system_t::nonzeros == 3);
+  CHECK((system_t::row_offsets == std::array<std::size_t, 3>{0, 1, 3}));
+  CHECK((system_t::columns == std::array<unsigned, 3>{0, 0, 1}));
+  std::array<double, 3> values;
+  system.EvaluateSparse(state, f, values);
+  CHECK_NEAR(values[0], std::sin(1.0), 1e-15);
+  CHECK_NEAR(values[1], 2.0, 1e-15);
+  CHECK_NEAR(values[2], 1.0, 1e-15);
+}
+
+void SharedSubexpressions() {
+  auto [x, y] = MakeVariables<2>();
+  OdeSystem system(Exp(x) * y, Exp(x) + y * Constant(3.0));
+  const std::array<double, 2> state{0.3, 0.7};
+  std::array<double, 2> f;
+  std::array<std::array<double, 2>, 2> jac;
+  system.Evaluate(state, f, jac);
+  CHECK_NEAR(f[0], std::exp(0.3) * 0.7, 1e-15);
+  CHECK_NEAR(f[1], std::exp(0.3) + 2.1, 1e-15);
+  CHECK_NEAR(jac[0][0], std::exp(0.3) * 0.7, 1e-15);
+  CHECK_NEAR(jac[0][1], std::exp(0.3), 1e-15);
+  CHECK_NEAR(jac[1][0], std::exp(0.3), 1e-15);
+  CHECK_NEAR(jac[1][1], 3.0, 1e-15);
+}
+
+// y' = -y, y(0) = 1 integrated to t = 1.
+void Steppers() {
+  auto [y] = MakeVariables<1>();
+  OdeSystem decay(-y);
+
+  std::vector<std::array<double, 1>> rk4(3, {1.0});
+  StepRK4Batch(decay, rk4, 0.01, 100, 2);
+  for (const auto& state : rk4)
+    CHECK_NEAR(state[0], std::exp(-1.0), 1e-10);
+
+  std::vector<std::array<double, 1>> euler(3, {1.0});
+  const auto failed = StepImplicitEulerBatch(decay, euler, 0.01, 100, 2);
+  for (std::size_t lane = 0; lane < euler.size(); ++lane) {
+    CHECK(!failed[lane]);
+    CHECK_NEAR(euler[lane][0], std::pow(1 / 1.01, 100), 1e-12);
+  }
+}
+
+// A lane whose Newton iteration does not converge keeps its last accepted state.
+void ImplicitEulerFailure() {
+  auto [x, y, z] = MakeVariables<3>();
+  OdeSystem robertson(Constant(-0.04) * x + Constant(1e4) * y * z,
+                      Constant(0.04) * x - Constant(1e4) * y * z - Constant(3e7) * y * y, Constant(3e7) * y * y);
+  std::vector<std::array<double, 3>> states{{1.0, 0.0, 0.0}};
+  const auto failed = StepImplicitEulerBatch(robertson, states, 1.0, 5, 1, 1);
+  CHECK(failed[0]);
+  CHECK((states[0] == std::array<double, 3>{1.0, 0.0, 0.0}));
+}
+}  // namespace
+
+int main() {
+  JacobianKnownAnswer();
+  SharedSubexpressions();
+  Steppers();
+  ImplicitEulerFailure();
+  return Tests::failures != 0;
+}
\ No newline at end of file
@@ -0,0 +1,108 @@
+#include "../SymbolicMath.hpp"
+#include "Check.hpp"
+
+#include <sstream>
+#include <string>
+
+using namespace SymbolicMath;
+
+namespace {
+constexpr unsigned evaluations = 100;
+
+// The same x*y subtree below two parents, evaluated a known number of times.
+void CallCounts() {
+  auto [x, y] = MakeVariables<2>();
+  const auto expr = Sin(x * y) + x * y;
+  Profiler profiler;
+  for (unsigned i = 0; i < evaluations; ++i)
+    Profile(profiler, expr, 0.5 + i, 2.0);
+
+  auto by_type = profiler.ByNodeType();
+  CHECK(by_type.size() == 3);
+  CHECK(by_type["_Plus"].calls == evaluations);
+  CHECK(by_type["_Sin"].calls == evaluations);
+  CHECK(by_type["_Multiply"].calls == 2 * evaluations);
+
+  const auto by_subtree = profiler.BySubtree();
+  CHECK(by_subtree.size() == 3);
+  CHECK(by_subtree.at(GetTypeName<std::decay_t<decltype(x * y)>>()).calls == 2 * evaluations);
+  CHECK(by_subtree.at(GetTypeName<std::decay_t<decltype(expr)>>()).calls == evaluations);
+
+  std::ostringstream folded;
+  profiler.DumpFolded(folded);
+  std::istringstream lines(folded.str());
+  std::string line;
+  unsigned stacks = 0;
+  while (std::getline(lines, line)) {
+    const auto stack = line.substr(0, line.rfind(' '));
+    CHECK(stack == "_Plus" || stack == "_Plus;_Sin" || stack == "_Plus;_Sin;_Multiply" || stack == "_Plus;_Multiply");
+    CHECK(line.find_first_not_of("0123456789", line.rfind(' ') + 1) == std::string::npos);
+    ++stacks;
+  }
+  CHECK(stacks == 4);
+
+  std::ostringstream totals;
+  profiler.DumpTotals(totals);
+  CHECK(totals.str().rfind("node_type\tcalls\ttotal_ns\tself_ns\n", 0) == 0);
+  CHECK(totals.str().find("\nsubtree\tcalls\ttotal_ns\tself_ns\n") != std::string::npos);
+}
+
+void Times() {
+  auto [x, y] = MakeVariables<2>();
+  const auto expr = Exp(Sin(x) * Cos(y)) / (x + y) - Sin(Sin(x));
+  Profiler profiler;
+  for (unsigned i = 0; i < evaluations; ++i)
+    Profile(profiler, expr, 0.5 + i, 2.0);
+
+  const auto& frames = profiler.GetFrames();
+  const auto inclusive = profiler.InclusiveTimes();
+  const auto self = profiler.SelfTimes();
+  CHECK(frames[1].parent == 0 && frames[0].children.size() == 1);
+  auto self_sum = Profiler::duration::zero();
+  for (std::size_t index = 1; index < frames.size(); ++index) {
+    CHECK(self[index] >= Profiler::duration::zero());
+    CHECK(inclusive[index] >= self[index]);
+    self_sum += self[index];
+  }
+  CHECK(self_sum <= inclusive[1]);
+
+  // Sin(Sin(x)) nests _Sin in _Sin: the outer frame's inclusive time already holds the inner one.
+  auto sin_total = Profiler::duration::zero();
+  for (std::size_t index = 1; index < frames.size(); ++index)
+    if (GetNodeName(frames[index].type_name) == "_Sin" && GetNodeName(frames[frames[index].parent].type_name) != "_Sin")
+      sin_total += inclusive[index];
+  CHECK(profiler.ByNodeType().at("_Sin").total == sin_total);
+}
+
+void SameValue() {
+  auto [x, y] = MakeVariables<2>();
+  const auto expr = Exp(Sin(x) * Cos(y)) / (x + y) - Tan(x * y);
+  Profiler profiler;
+  CHECK(Profile(profiler, expr, 0.3, 1.7) == expr(0.3, 1.7));
+  CHECK(Profile(profiler, Sin(x), 0.3) == Sin(x)(0.3));
+  profiler.Reset();
+  CHECK(profiler.GetFrames().size() == 1);
+}
+
+void Cycles() {
+  auto [x, y] = MakeVariables<2>();
+  const auto expr = Sin(x * y) + x * y;
+  CycleProfiler profiler;
+  CHECK(CycleProfiler::unit == "cycles");
+  for (unsigned i = 0; i < evaluations; ++i)
+    CHECK(Profile(profiler, expr, 0.5 + i, 2.0) == expr(0.5 + i, 2.0));
+  CHECK(profiler.ByNodeType().at("_Multiply").calls == 2 * evaluations);
+
+  std::ostringstream totals;
+  profiler.DumpTotals(totals);
+  CHECK(totals.str().rfind("node_type\tcalls\ttotal_cycles\tself_cycles\n", 0) == 0);
+}
+}  // namespace
+
+int main() {
+  CallCounts();
+  Times();
+  SameValue();
+  Cycles();
+  return Tests::failures != 0;
+}
\ No newline at end of file
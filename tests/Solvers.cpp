@@ -0,0 +1,122 @@
+#include "../SymbolicMath.hpp"
+#include "Check.hpp"
+
+#include <cmath>
+#include <limits>
+
+using namespace SymbolicMath;
+
+namespace {
+const double pi = std::acos(-1.0);
+
+// Negated unary objectives and equations, which the solvers once saw with the negation dropped.
+void NegatedUnary() {
+  auto [t] = MakeVariables<1>();
+  std::vector<std::array<double, 1>> minimum{{0.3}};
+  CHECK(MinimizeBatch(-Cos(t), minimum) == 0);
+  CHECK_NEAR(minimum[0][0], 0.0, 1e-8);
+
+  std::vector<std::array<double, 1>> root{{1.0}};
+  CHECK(SolveBatch(-Cos(t), root) == 0);
+  CHECK_NEAR(root[0][0], pi / 2, 1e-8);
+}
+
+void Rosenbrock() {
+  auto [x, y] = MakeVariables<2>();
+  const auto one = Constant(1.0);
+  const auto rosenbrock = (one - x) * (one - x) + Constant(100.0) * (y - x * x) * (y - x * x);
+  std::vector<std::array<double, 2>> points{{-1.2, 1.0}, {0.0, 0.0}, {2.0, -1.0}, {-1.5, 2.5}};
+  CHECK(MinimizeBatch(rosenbrock, points, 2) == 0);
+  for (const auto& point : points) {
+    CHECK_NEAR(point[0], 1.0, 1e-6);
+    CHECK_NEAR(point[1], 1.0, 1e-6);
+  }
+}
+
+// x^2 + y^2 = 4 intersected with y = sin(x) has the roots +-(1.7392..., 0.9864...).
+void CircleSine() {
+  auto [x, y] = MakeVariables<2>();
+  const auto circle = std::make_tuple(x * x + y * y - Constant(4.0), Sin(x) - y);
+  std::vector<std::array<double, 2>> points{{1.0, 1.0}, {2.0, 0.5}, {-1.0, -1.0}};
+  CHECK(SolveBatch(circle, points, 2) == 0);
+  for (const auto& [px, py] : points) {
+    CHECK_NEAR(px * px + py * py, 4.0, 1e-8);
+    CHECK_NEAR(std::sin(px), py, 1e-8);
+  }
+}
+
+// x^2 + 1 has no real root. Newton walks towards the minimum of the residual at 0 until no halved step reduces
+// it; the lane then fails at its last iterate, wherever the iteration limit lies, instead of accepting a step that
+// makes it worse and wandering off.
+void HalvingFailure() {
+  auto [x] = MakeVariables<1>();
+  std::vector<std::array<double, 1>> short_run{{0.5}}, long_run{{0.5}};
+  CHECK(SolveBatch(x * x + Constant(1.0), short_run, 1, 20) == 1);
+  CHECK(SolveBatch(x * x + Constant(1.0), long_run, 1, 1000) == 1);
+  CHECK(std::abs(long_run[0][0]) < 1e-6);
+  CHECK(short_run == long_run);
+}
+
+// Blocks of several lanes, with a batch that does not fill the last block and a singular lane among converging
+// ones, give the same lanes as one lane at a time.
+template <std::size_t W>
+void LaneWidth() {
+  auto [x] = MakeVariables<1>();
+  std::vector<std::array<double, 1>> points{{1.0}, {-3.0}, {0.0}, {0.5}, {-0.25}, {4.0}, {2.0}};
+  CHECK(SolveBatch<W>(x * x - Constant(2.0), points) == 1);
+  CHECK(points[2][0] == 0.0);
+  for (std::size_t lane = 0; lane < points.size(); ++lane)
+    if (lane != 2)
+      CHECK_NEAR(std::abs(points[lane][0]), std::sqrt(2.0), 1e-8);
+
+  auto [u, v] = MakeVariables<2>();
+  const auto one = Constant(1.0);
+  const auto rosenbrock = (one - u) * (one - u) + Constant(100.0) * (v - u * u) * (v - u * u);
+  std::vector<std::array<double, 2>> scalar{{-1.2, 1.0}, {0.0, 0.0}, {2.0, -1.0}, {-1.5, 2.5}, {0.5, 0.5}};
+  auto blocked = scalar;
+  CHECK(MinimizeBatch<1>(rosenbrock, scalar) == MinimizeBatch<W>(rosenbrock, blocked));
+  for (std::size_t lane = 0; lane < scalar.size(); ++lane) {
+    CHECK_NEAR(blocked[lane][0], scalar[lane][0], 1e-12);
+    CHECK_NEAR(blocked[lane][1], scalar[lane][1], 1e-12);
+  }
+}
+
+// Lane blocks of scalar types other than double: float, and long double, which is wider than any lane mask integer.
+template <class T>
+void ScalarType() {
+  auto [x] = MakeVariables<1>();
+  const T tolerance = std::sqrt(std::numeric_limits<T>::epsilon());
+  std::vector<std::array<T, 1>> roots{{T(1)}, {T(-3)}, {T(0)}, {T(0.5)}, {T(-0.25)}, {T(4)}, {T(2)}};
+  auto blocked_roots = roots;
+  CHECK(SolveBatch<1>(x * x - Constant(T(2)), roots) == 1);
+  CHECK(SolveBatch<4>(x * x - Constant(T(2)), blocked_roots) == 1);
+  CHECK(roots == blocked_roots);
+  CHECK(roots[2][0] == T(0));
+  for (std::size_t lane = 0; lane < roots.size(); ++lane)
+    if (lane != 2)
+      CHECK(std::abs(std::abs(roots[lane][0]) - std::sqrt(T(2))) < tolerance);
+
+  auto [u, v] = MakeVariables<2>();
+  const auto bowl = (u - Constant(T(1))) * (u - Constant(T(1))) + Constant(T(3)) * (v + u) * (v + u);
+  std::vector<std::array<T, 2>> minima{{T(-1.2), T(1)}, {T(0), T(0)}, {T(2), T(-1)}, {T(-1.5), T(2.5)}, {T(5), T(5)}};
+  auto blocked_minima = minima;
+  CHECK(MinimizeBatch<1>(bowl, minima) == 0);
+  CHECK(MinimizeBatch<4>(bowl, blocked_minima) == 0);
+  CHECK(minima == blocked_minima);
+  for (const auto& point : minima)
+    CHECK(std::abs(point[0] - T(1)) < tolerance && std::abs(point[1] + T(1)) < tolerance);
+}
+}  // namespace
+
+int main() {
+  NegatedUnary();
+  Rosenbrock();
+  CircleSine();
+  HalvingFailure();
+  LaneWidth<1>();
+  LaneWidth<4>();
+  LaneWidth<8>();
+  ScalarType<float>();
+  ScalarType<long double>();
+  return Tests::failures != 0;
+}
\ No newline at end of file